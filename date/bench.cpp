@@ -0,0 +1,183 @@
+/**
+ * @file bench.cpp
+ * @brief Micro-benchmarks for the Date class and the batch kernels.
+ *
+ * Prints one JSON object to stdout: for every benchmark, the number of operations
+ * per run and the best time per operation over several runs.
+ *
+ * Usage: bench_date [elements]   (default: 1048576 elements per run)
+ */
+
+#include <algorithm>  // std::min.
+#include <charconv>   // std::to_chars_result.
+#include <chrono>     // std::chrono::steady_clock.
+#include <cstddef>    // std::size_t.
+#include <cstdint>    // std::int64_t, std::uint64_t.
+#include <cstdlib>    // std::strtoull.
+#include <iostream>   // std::cout.
+#include <span>       // std::span.
+#include <string>     // std::string, std::to_string.
+#include <utility>    // std::move.
+#include <vector>     // std::vector.
+
+#include "date.hpp"
+#include "date_column.hpp"
+
+namespace {
+
+using setm::Date;
+using setm::DateColumn;
+
+// Number of timed runs per benchmark; the fastest one is reported.
+constexpr int RUNS{ 5 };
+
+// Keeps results alive so the compiler cannot drop the measured work.
+volatile std::uint64_t sink;
+
+struct Result {
+    std::string name;
+    std::size_t operations;
+    double nanosecondsPerOperation;
+};
+
+// Times body() (which performs `operations` operations and returns a checksum).
+template<typename F>
+Result Measure(std::string name, std::size_t operations, F body) {
+    double best{ 1e300 };
+    for(int run{}; run < RUNS; ++run) {
+        const auto start{ std::chrono::steady_clock::now() };
+        sink = sink + static_cast<std::uint64_t>(body());
+        const std::chrono::duration<double, std::nano> elapsed{ std::chrono::steady_clock::now() - start };
+        best = std::min(best, elapsed.count());
+    }
+    return { std::move(name), operations, best / static_cast<double>(operations) };
+}
+
+// Pseudo-random dates between 1900/1/1 and 2100/12/31.
+std::vector<Date> MakeDates(std::size_t count, std::uint64_t seed) {
+    std::vector<Date> dates;
+    dates.reserve(count);
+    std::uint64_t state{ seed };
+    for(std::size_t i{}; i < count; ++i) {
+        state = state * 6364136223846793005 + 1442695040888963407;
+        dates.push_back(Date::CivilFromDays(-25567 + static_cast<std::int64_t>((state >> 33) % 73414)));
+    }
+    return dates;
+}
+
+void PrintJson(const std::vector<Result>& results, std::size_t elements) {
+    std::cout << "{\n  \"elements\": " << elements << ",\n  \"runs\": " << RUNS << ",\n  \"benchmarks\": [\n";
+    for(std::size_t i{}; i < results.size(); ++i) {
+        std::cout << "    { \"name\": \"" << results[i].name << "\", \"operations\": " << results[i].operations
+                  << ", \"ns_per_op\": " << results[i].nanosecondsPerOperation << " }" << (i + 1 < results.size() ? "," : "")
+                  << '\n';
+    }
+    std::cout << "  ]\n}\n";
+}
+
+}  // Anonymous namespace.
+
+int main(int argc, char* argv[]) {
+    const std::size_t elements{ argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{ 1 } << 20 };
+    if(elements == 0) {
+        std::cerr << "Usage: bench_date [elements]\n";
+        return 1;
+    }
+
+    const std::vector<Date> dates{ MakeDates(elements, 1) };
+    const std::vector<Date> others{ MakeDates(elements, 2) };
+    std::vector<Result> results;
+
+    results.push_back(Measure("Construct", elements, [&dates] {
+        std::uint64_t checksum{};
+        for(const Date& date : dates)
+            checksum += Date{ date.Year(), date.Month(), date.Day() }.Day();
+        return checksum;
+    }));
+
+    for(unsigned offset{ 1 }; offset <= 10'000'000; offset *= 10) {
+        results.push_back(Measure("AddDays/" + std::to_string(offset), elements, [&dates, offset] {
+            std::uint64_t checksum{};
+            for(Date date : dates) {
+                date.AddDays(offset);
+                checksum += date.Day();
+            }
+            return checksum;
+        }));
+    }
+
+    results.push_back(Measure("Difference", elements, [&dates, &others] {
+        std::uint64_t checksum{};
+        for(std::size_t i{}; i < dates.size(); ++i)
+            checksum += Date::Difference(dates[i], others[i]);
+        return checksum;
+    }));
+
+    results.push_back(Measure("DayOfYear", elements, [&dates] {
+        std::uint64_t checksum{};
+        for(const Date& date : dates)
+            checksum += Date::DayOfYear(date);
+        return checksum;
+    }));
+
+    results.push_back(Measure("ToChars", elements, [&dates] {
+        std::uint64_t checksum{};
+        char buffer[16];
+        for(const Date& date : dates) {
+            const std::to_chars_result result{ date.ToChars(buffer, buffer + sizeof(buffer)) };
+            checksum += static_cast<std::uint64_t>(result.ptr - buffer) + static_cast<unsigned char>(buffer[9]);
+        }
+        return checksum;
+    }));
+
+    std::string text;
+    text.reserve(elements * 11);
+    for(const Date& date : dates) {
+        char buffer[16];
+        text.append(buffer, date.ToChars(buffer, buffer + sizeof(buffer)).ptr);
+        text.push_back('\n');
+    }
+
+    results.push_back(Measure("FromChars", elements, [&text] {
+        std::uint64_t checksum{};
+        Date date{ Date::CivilFromDays(0) };
+        for(const char* current{ text.data() }; current < text.data() + text.size(); current += 11) {
+            static_cast<void>(Date::FromChars(current, current + 10, date));
+            checksum += date.Day();
+        }
+        return checksum;
+    }));
+
+    // Batch kernels (split across hardware threads for large inputs).
+    const std::vector<int> offsets(elements, 1'000'000);
+    results.push_back(Measure("Batch/AddDays/span", elements, [&dates, &offsets] {
+        std::vector<Date> copy{ dates };
+        setm::AddDays(copy, offsets);
+        return copy.back().Day();
+    }));
+
+    const DateColumn column{ dates };
+    const DateColumn otherColumn{ others };
+    results.push_back(Measure("Batch/AddDays/column", elements, [&column, &offsets] {
+        DateColumn copy{ column };
+        setm::AddDays(copy, offsets);
+        return copy[copy.Size() - 1].Day();
+    }));
+
+    std::vector<std::int64_t> differences(elements);
+    results.push_back(Measure("Batch/Difference/column", elements, [&column, &otherColumn, &differences] {
+        setm::Difference(column, otherColumn, differences);
+        return differences.back();
+    }));
+
+    std::vector<unsigned> daysOfYear(elements);
+    results.push_back(Measure("Batch/DayOfYear/column", elements, [&column, &daysOfYear] {
+        setm::DayOfYear(column, daysOfYear);
+        return daysOfYear.back();
+    }));
+
+    results.push_back(Measure("Batch/Parse", elements, [&text] { return DateColumn::Parse(text).Size(); }));
+
+    PrintJson(results, elements);
+    return 0;
+}
@@ -0,0 +1,102 @@
+#include "business_calendar.hpp"
+
+#include <bit>         // std::popcount.
+#include <cstddef>     // std::size_t.
+#include <cstdint>     // std::int32_t, std::int64_t, std::uint64_t.
+#include <filesystem>  // std::filesystem::path.
+#include <span>        // std::span.
+#include <stdexcept>   // std::invalid_argument, std::out_of_range.
+#include <vector>      // std::vector.
+
+#include "date.hpp"         // setm::Date.
+#include "date_column.hpp"  // setm::DateColumn.
+
+namespace setm {
+
+BusinessCalendar::BusinessCalendar(const Date& first, const Date& last, std::span<const Date> holidays)
+    : firstDay_{ first.ToDays() }, size_{ last.ToDays() - first.ToDays() + 1 } {
+    if(size_ <= 0)
+        throw std::invalid_argument("Invalid calendar range.");
+
+    // Mark the weekdays, then clear the holidays.
+    bitmap_.assign(static_cast<std::size_t>((size_ + 63) / 64), 0);
+    const unsigned firstWeekday{ Date::DayOfWeek(first) };
+    for(std::int64_t offset{}; offset < size_; ++offset) {
+        if((firstWeekday - 1 + offset) % 7 < 5)
+            bitmap_[static_cast<std::size_t>(offset / 64)] |= std::uint64_t{ 1 } << (offset % 64);
+    }
+    for(const Date& holiday : holidays) {
+        const std::int64_t offset{ holiday.ToDays() - firstDay_ };
+        if(offset >= 0 && offset < size_)
+            bitmap_[static_cast<std::size_t>(offset / 64)] &= ~(std::uint64_t{ 1 } << (offset % 64));
+    }
+
+    prefix_.reserve(bitmap_.size() + 1);
+    prefix_.push_back(0);
+    for(const std::uint64_t word : bitmap_)
+        prefix_.push_back(prefix_.back() + std::popcount(word));
+
+    positions_.reserve(static_cast<std::size_t>(prefix_.back()));
+    for(std::int64_t offset{}; offset < size_; ++offset) {
+        if(bitmap_[static_cast<std::size_t>(offset / 64)] >> (offset % 64) & 1)
+            positions_.push_back(static_cast<std::int32_t>(offset));
+    }
+}
+
+[[nodiscard]] bool BusinessCalendar::IsBusinessDay(const Date& date) const {
+    const std::int64_t offset{ Offset(date, size_ - 1) };
+    return bitmap_[static_cast<std::size_t>(offset / 64)] >> (offset % 64) & 1;
+}
+
+[[nodiscard]] Date BusinessCalendar::AddBusinessDays(const Date& date, std::int64_t numDays) const {
+    const std::int64_t offset{ Offset(date, size_ - 1) };
+    if(numDays == 0)
+        return date;
+
+    // Index (in positions_) of the resulting business day.
+    const std::int64_t index{ numDays > 0 ? Rank(offset + 1) + numDays - 1 : Rank(offset) + numDays };
+    if(index < 0 || index >= static_cast<std::int64_t>(positions_.size()))
+        throw std::out_of_range("Result is outside of the calendar.");
+
+    return Date::CivilFromDays(firstDay_ + positions_[static_cast<std::size_t>(index)]);
+}
+
+[[nodiscard]] std::int64_t BusinessCalendar::BusinessDaysBetween(const Date& from, const Date& to) const {
+    return Rank(Offset(to, size_)) - Rank(Offset(from, size_));
+}
+
+[[nodiscard]] Date BusinessCalendar::First() const noexcept {
+    return Date::CivilFromDays(firstDay_);
+}
+
+[[nodiscard]] Date BusinessCalendar::Last() const noexcept {
+    return Date::CivilFromDays(firstDay_ + size_ - 1);
+}
+
+BusinessCalendar BusinessCalendar::FromFile(const std::filesystem::path& path, const Date& first, const Date& last) {
+    const DateColumn holidays{ DateColumn::ReadFile(path) };
+
+    std::vector<Date> dates;
+    dates.reserve(holidays.Size());
+    for(std::size_t i{}; i < holidays.Size(); ++i)
+        dates.push_back(holidays[i]);
+
+    return BusinessCalendar{ first, last, dates };
+}
+
+[[nodiscard]] std::int64_t BusinessCalendar::Rank(std::int64_t offset) const noexcept {
+    const std::size_t word{ static_cast<std::size_t>(offset / 64) };
+    const std::uint64_t bit{ static_cast<std::uint64_t>(offset % 64) };
+    if(bit == 0)
+        return prefix_[word];
+    return prefix_[word] + std::popcount(bitmap_[word] & ((std::uint64_t{ 1 } << bit) - 1));
+}
+
+[[nodiscard]] std::int64_t BusinessCalendar::Offset(const Date& date, std::int64_t limit) const {
+    const std::int64_t offset{ date.ToDays() - firstDay_ };
+    if(offset < 0 || offset > limit)
+        throw std::out_of_range("Date is outside of the calendar.");
+    return offset;
+}
+
+}  // namespace setm
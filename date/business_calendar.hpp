@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>     // std::int32_t, std::int64_t, std::uint64_t.
+#include <filesystem>  // std::filesystem::path.
+#include <span>        // std::span.
+#include <vector>      // std::vector.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+/**
+ * @brief Business-day calendar over a fixed range of dates.
+ *
+ * Business days are Monday to Friday, except for the holidays. The calendar precomputes
+ * a bitmap of business days, the number of business days before every 64-day block,
+ * and the list of all business days, so every query runs in constant time.
+ * The calendar is immutable after construction and can be queried from many threads at once.
+ */
+class BusinessCalendar {
+public:
+    // ========= Constructors: ========= //
+    /**
+     * @brief Constructs a calendar for the dates in [first, last].
+     *
+     * @param first The first date covered by the calendar.
+     * @param last The last date covered by the calendar.
+     * @param holidays The holidays (dates outside of the range are ignored).
+     * @throws std::invalid_argument if last is before first.
+     */
+    BusinessCalendar(const Date& first, const Date& last, std::span<const Date> holidays = {});
+
+
+    // ========= Methods: ========= //
+    /**
+     * @brief Checks if a date is a business day.
+     *
+     * @param date The date to check.
+     * @return True if the date is neither a weekend nor a holiday.
+     * @throws std::out_of_range if the date is outside of the calendar.
+     */
+    [[nodiscard]] bool IsBusinessDay(const Date& date) const;
+
+    /**
+     * @brief Moves a date by a number of business days.
+     *
+     * @param date The starting date (not necessarily a business day).
+     * @param numDays The number of business days to move (negative to move backwards).
+     * @return The numDays-th business day after (or before) the date; the date itself for 0.
+     * @throws std::out_of_range if the date or the result is outside of the calendar.
+     */
+    [[nodiscard]] Date AddBusinessDays(const Date& date, std::int64_t numDays) const;
+
+    /**
+     * @brief Counts the business days in [from, to).
+     *
+     * @param from The first date.
+     * @param to The date after the last one.
+     * @return The number of business days (negative if to is before from).
+     * @throws std::out_of_range if a date is outside of the calendar (to may be the day after the last one).
+     */
+    [[nodiscard]] std::int64_t BusinessDaysBetween(const Date& from, const Date& to) const;
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] Date First() const noexcept;
+    [[nodiscard]] Date Last() const noexcept;
+
+
+    // ========= Static functions: ========= //
+    /**
+     * @brief Constructs a calendar with the holidays listed in a file.
+     *
+     * @param path The file with one holiday per line (in a format accepted by Date::FromChars).
+     * @param first The first date covered by the calendar.
+     * @param last The last date covered by the calendar.
+     * @return The calendar.
+     * @throws std::runtime_error if the file cannot be read.
+     * @throws std::invalid_argument if a line is not a valid date.
+     */
+    [[nodiscard]] static BusinessCalendar FromFile(const std::filesystem::path& path, const Date& first, const Date& last);
+
+
+private:
+    // Number of business days in [First(), the day with the given offset).
+    [[nodiscard]] std::int64_t Rank(std::int64_t offset) const noexcept;
+
+    // Offset of the date from First(), validated against [0, limit].
+    [[nodiscard]] std::int64_t Offset(const Date& date, std::int64_t limit) const;
+
+    std::int64_t firstDay_;                // Serial day number of the first date.
+    std::int64_t size_;                    // Number of dates in the calendar.
+    std::vector<std::uint64_t> bitmap_;    // Bit i is set if the day First() + i is a business day.
+    std::vector<std::int32_t> prefix_;     // Number of business days before every 64-day block.
+    std::vector<std::int32_t> positions_;  // Offsets of all business days, in order.
+};
+
+}  // namespace setm
@@ -1,100 +1,143 @@
 #include "date.hpp"
 
-#include <array>      // std::array.
-#include <cstddef>    // std::size_t.
-#include <ostream>    // std::ostream.
-#include <stdexcept>  // std::invalid_argument.
+#include <charconv>      // std::from_chars_result, std::to_chars, std::to_chars_result.
+#include <cstddef>       // std::size_t.
+#include <cstdint>       // std::int64_t, std::uint64_t.
+#include <cstring>       // std::memcpy, std::memset.
+#include <limits>        // std::numeric_limits.
+#include <ostream>       // std::ostream.
+#include <system_error>  // std::errc.
 
 namespace setm {
 
-Date::Date(int year, unsigned month, unsigned day)
-    : year_{ year }, month_{ month }, day_{ day } {
-    if(month_ < 1 || month_ > 12)
-        throw std::invalid_argument("Invalid month.");
-    if(day_ < 1 || day_ > DaysInMonth(year_, month_))
-        throw std::invalid_argument("Invalid day.");
-}
+namespace {
 
-void Date::AddDays(unsigned numDays) noexcept {
-    while(numDays > 0) {
-        const unsigned daysInMonth{ DaysInMonth(year_, month_) };
-        const unsigned daysRemaining{ daysInMonth - day_ + 1 };
-        if(numDays >= daysRemaining) {
-            // Move to the next month
-            numDays -= daysRemaining;
-            day_ = 1;
-
-            if(++month_ > 12) {
-                month_ = 1;
-                ++year_;
-            }
-        } else {
-            // Stay in the current month.
-            day_ += numDays;
-            numDays = 0;
-        }
-    }
+// Checks that all 8 bytes of a little-endian word are ASCII digits (SWAR).
+constexpr bool AllDigits(std::uint64_t chunk) noexcept {
+    // Every byte must be 0x3X, and adding 6 to it must not carry out of the low nibble.
+    return (chunk & 0xF0F0F0F0F0F0F0F0) == 0x3030303030303030 &&
+           ((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) == 0x3030303030303030;
 }
 
-[[nodiscard]] int Date::Year() const noexcept {
-    return year_;
+// Converts 8 ASCII digits (first digit in the lowest byte) to their value (SWAR).
+constexpr std::uint32_t ParseEightDigits(std::uint64_t chunk) noexcept {
+    chunk -= 0x3030303030303030;
+    chunk = (chunk * 10 + (chunk >> 8)) & 0x00FF00FF00FF00FF;           // Pairs of digits.
+    chunk = (chunk * 100 + (chunk >> 16)) & 0x0000FFFF0000FFFF;         // Groups of four digits.
+    return static_cast<std::uint32_t>((chunk * 10000 + (chunk >> 32)) & 0xFFFFFFFF);
 }
 
-[[nodiscard]] unsigned Date::Month() const noexcept {
-    return month_;
+// Parses two ASCII digits, or returns -1.
+constexpr int ParseTwoDigits(const char* digits) noexcept {
+    if(digits[0] < '0' || digits[0] > '9' || digits[1] < '0' || digits[1] > '9')
+        return -1;
+    return (digits[0] - '0') * 10 + (digits[1] - '0');
 }
 
-[[nodiscard]] unsigned Date::Day() const noexcept {
-    return day_;
+// Loads 8 bytes as a little-endian word.
+std::uint64_t LoadEightBytes(const char* bytes) noexcept {
+    std::uint64_t chunk{};
+    for(std::size_t i{}; i < 8; ++i)
+        chunk |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+    return chunk;
 }
 
-std::size_t Date::CountLeapYears(const Date& date) {
-    std::size_t years{ static_cast<std::size_t>(date.Year()) };
-    if(date.Month() <= 2)
-        years--;
-
-    // An year is a leap year if it is:
-    // 1. a multiple of 4,
-    // 2. multiple of 400
-    // 3. and not a multiple of 100.
-    return years / 4 - years / 100 + years / 400;
-}
-
-std::size_t Date::Difference(const Date& first, const Date& second) noexcept {
-    // Calculate total days from year 0 to the given date, including leap years.
-    auto TotalDaysUpToYear{ [](const Date& date) {
-        // Account for leap years in the total day count.
-        return date.Year() * 365 + CountLeapYears(date) + DayOfYear(date);
-    } };
-
-    const auto daysInFirstDate{ TotalDaysUpToYear(first) };
-    const auto daysInSecondDate{ TotalDaysUpToYear(second) };
-
-    // Calculate the difference in days between the two dates.
-    return std::max(daysInFirstDate, daysInSecondDate) - std::min(daysInFirstDate, daysInSecondDate);
-}
+}  // Anonymous namespace.
+
+std::from_chars_result Date::FromChars(const char* first, const char* last, Date& value) noexcept {
+    const std::size_t length{ static_cast<std::size_t>(last - first) };
+
+    // Expanded year: a sign, at least four digits, then "-MM-DD" or "/MM/DD".
+    if(length > 0 && (*first == '+' || *first == '-')) {
+        const char* const digits{ first + 1 };
+        const char* end{ digits };
+        while(end != last && *end >= '0' && *end <= '9')
+            ++end;
+        if(end - digits < 4 || last - end < 6 || (end[0] != '-' && end[0] != '/') || end[3] != end[0])
+            return { first, std::errc::invalid_argument };
+
+        std::int64_t magnitude{};
+        const std::from_chars_result parsed{ std::from_chars(digits, end, magnitude) };
+        const int month{ ParseTwoDigits(end + 1) };
+        const int day{ ParseTwoDigits(end + 4) };
+        if(parsed.ec != std::errc{} || magnitude > std::numeric_limits<int>::max() || month < 1 || month > 12)
+            return { first, std::errc::invalid_argument };
+        const int year{ static_cast<int>(*first == '-' ? -magnitude : magnitude) };
+        if(day < 1 || static_cast<unsigned>(day) > DaysInMonth(year, static_cast<unsigned>(month)))
+            return { first, std::errc::invalid_argument };
+
+        value = Date{ year, static_cast<unsigned>(month), static_cast<unsigned>(day), Unchecked{} };
+        return { end + 6, std::errc{} };
+    }
 
-unsigned Date::DaysInMonth(int year, unsigned month) {
-    static const std::array<unsigned, 12> DAYS_IN_MONTH_ = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    if(length < 8)
+        return { first, std::errc::invalid_argument };
+
+    // Gather the 8 digits of the separated forms into one word.
+    char digits[8];
+    std::size_t consumed{ 8 };
+    const bool separated{ length >= 10 && (first[4] == '-' || first[4] == '/') };
+    if(separated) {
+        if(first[7] != first[4])
+            return { first, std::errc::invalid_argument };
+        std::memcpy(digits, first, 4);
+        std::memcpy(digits + 4, first + 5, 2);
+        std::memcpy(digits + 6, first + 8, 2);
+        consumed = 10;
+    } else {
+        std::memcpy(digits, first, 8);
+    }
 
-    // It it's February, check if it's a leap year.
-    if(month == 2)
-        return IsLeapYear(year) ? 29 : 28;
+    const std::uint64_t chunk{ LoadEightBytes(digits) };
+    if(!AllDigits(chunk))
+        return { first, std::errc::invalid_argument };
 
-    return DAYS_IN_MONTH_[month - 1];
-}
+    const std::uint32_t number{ ParseEightDigits(chunk) };  // YYYYMMDD.
+    const int year{ static_cast<int>(number / 10000) };
+    const unsigned month{ number / 100 % 100 };
+    const unsigned day{ number % 100 };
+    if(month < 1 || month > 12 || day < 1 || day > DaysInMonth(year, month))
+        return { first, std::errc::invalid_argument };
 
-bool Date::IsLeapYear(int year) {
-    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+    value = Date{ year, month, day, Unchecked{} };
+    return { first + consumed, std::errc{} };
 }
 
-unsigned Date::DayOfYear(const Date& date) {
-    unsigned dayOfYear{ date.day_ };
-
-    for(unsigned m{ 1 }; m < date.month_; ++m)
-        dayOfYear += DaysInMonth(date.year_, m);
+std::to_chars_result Date::ToChars(char* first, char* last) const noexcept {
+    char* out{ first };
+    if(year_ >= 0 && year_ <= 9999) {
+        // Fast path: fixed width "YYYY-MM-DD".
+        if(last - first < 10)
+            return { last, std::errc::value_too_large };
+        const unsigned year{ static_cast<unsigned>(year_) };
+        out[0] = static_cast<char>('0' + year / 1000);
+        out[1] = static_cast<char>('0' + year / 100 % 10);
+        out[2] = static_cast<char>('0' + year / 10 % 10);
+        out[3] = static_cast<char>('0' + year % 10);
+        out += 4;
+    } else {
+        // Expanded ISO-8601 year: a sign and at least four digits, so FromChars can read it back.
+        const std::int64_t year{ year_ };
+        char digits[16];
+        const char* const digitsEnd{ std::to_chars(digits, digits + sizeof(digits), year < 0 ? -year : year).ptr };
+        const std::size_t count{ static_cast<std::size_t>(digitsEnd - digits) };
+        const std::size_t padding{ count < 4 ? 4 - count : 0 };
+        if(static_cast<std::size_t>(last - first) < 1 + padding + count + 6)
+            return { last, std::errc::value_too_large };
+
+        *out++ = year < 0 ? '-' : '+';
+        std::memset(out, '0', padding);
+        std::memcpy(out + padding, digits, count);
+        out += padding + count;
+    }
 
-    return dayOfYear;
+    out[0] = '-';
+    out[1] = static_cast<char>('0' + month_ / 10);
+    out[2] = static_cast<char>('0' + month_ % 10);
+    out[3] = '-';
+    out[4] = static_cast<char>('0' + day_ / 10);
+    out[5] = static_cast<char>('0' + day_ % 10);
+    return { out + 6, std::errc{} };
 }
 
 std::ostream& operator<<(std::ostream& os, const Date& date) {
@@ -1,10 +1,14 @@
 #pragma once
 
-#include <array>      // std::array.
-#include <compare>    // std::strong_ordering.
-#include <cstddef>    // std::size_t.
-#include <ostream>    // std::ostream.
-#include <stdexcept>  // std::invalid_argument.
+#include <algorithm>   // std::max, std::min.
+#include <array>       // std::array.
+#include <charconv>    // std::from_chars_result, std::to_chars_result.
+#include <chrono>      // std::chrono::days, std::chrono::sys_days, std::chrono::year_month_day.
+#include <compare>     // std::strong_ordering.
+#include <cstddef>     // std::size_t.
+#include <cstdint>     // std::int64_t.
+#include <ostream>     // std::ostream.
+#include <stdexcept>   // std::invalid_argument, std::out_of_range.
 
 namespace setm {
 
@@ -25,7 +29,7 @@ public:
      * @param day The day of the date.
      * @throws std::invalid_argument if the month or day is out of valid range.
      */
-    Date(int year, unsigned month, unsigned day);
+    constexpr Date(int year, unsigned month, unsigned day);
 
 
     // ========= Methods: ========= //
@@ -33,15 +37,69 @@ public:
      * @brief Modifies the date by adding a specified number of days.
      *
      * @param numDays The number of days to add to the date.
-     * @note This function ensures that the date is updated correctly after adding days.
+     * @note Runs in constant time regardless of the number of days.
      */
-    void AddDays(unsigned numDays) noexcept;
+    constexpr void AddDays(unsigned numDays) noexcept;
+
+    /**
+     * @brief Modifies the date by subtracting a specified number of days.
+     *
+     * @param numDays The number of days to subtract from the date (negative to move forward).
+     * @note Runs in constant time regardless of the number of days.
+     */
+    constexpr void SubtractDays(std::int64_t numDays) noexcept;
+
+    /**
+     * @brief Modifies the date by adding a specified number of months.
+     *
+     * @param numMonths The number of months to add to the date (negative to move backward).
+     * @note The day is clamped to the length of the resulting month (2024/1/31 + 1 month is 2024/2/29).
+     */
+    constexpr void AddMonths(int numMonths) noexcept;
+
+    /**
+     * @brief Modifies the date by adding a specified number of years.
+     *
+     * @param numYears The number of years to add to the date (negative to move backward).
+     * @note February 29 becomes February 28 if the resulting year is not a leap year.
+     */
+    constexpr void AddYears(int numYears) noexcept;
+
+
+    /**
+     * @brief Formats the date as ISO-8601 "YYYY-MM-DD" (zero padded) into a caller buffer.
+     *
+     * @param first The beginning of the buffer.
+     * @param last The end of the buffer.
+     * @return ptr points past the written characters; ec is std::errc::value_too_large
+     * if the buffer is too small (the buffer contents are then unspecified).
+     * @note Years outside of [0, 9999] are written in the ISO-8601 expanded form: a sign and at
+     * least four digits ("-0101-01-02", "+12345-01-01"); at most 17 characters are written.
+     */
+    std::to_chars_result ToChars(char* first, char* last) const noexcept;
 
 
     // ========= Getters: ========= //
-    [[nodiscard]] int Year() const noexcept;
-    [[nodiscard]] unsigned Month() const noexcept;
-    [[nodiscard]] unsigned Day() const noexcept;
+    [[nodiscard]] constexpr int Year() const noexcept;
+    [[nodiscard]] constexpr unsigned Month() const noexcept;
+    [[nodiscard]] constexpr unsigned Day() const noexcept;
+
+    /**
+     * @brief Retrieves the serial day number of the date.
+     *
+     * @return The number of days since 1970/1/1 (negative for earlier dates).
+     */
+    [[nodiscard]] constexpr std::int64_t ToDays() const noexcept;
+
+    /**
+     * @brief Converts the date to the std::chrono calendar types.
+     *
+     * @return The equivalent std::chrono::year_month_day or std::chrono::sys_days.
+     * @throws std::out_of_range (ToYearMonthDay only) if the year does not fit std::chrono::year (-32767 to 32767).
+     * @note Both types share the proleptic Gregorian calendar and the 1970/1/1 epoch with Date.
+     */
+    [[nodiscard]] constexpr std::chrono::year_month_day ToYearMonthDay() const;
+    [[nodiscard]] constexpr std::chrono::sys_days ToSysDays() const noexcept;
 
 
     // ========= Comparison operators: ========= //
@@ -54,6 +112,30 @@ public:
     std::strong_ordering operator<=>(const Date& other) const noexcept = default;
 
 
+    // ========= Arithmetic operators: ========= //
+    /**
+     * @brief Moves the date by a signed std::chrono::days duration in constant time.
+     *
+     * @param days The duration to add (or subtract).
+     * @return The modified date.
+     */
+    constexpr Date& operator+=(std::chrono::days days) noexcept;
+    constexpr Date& operator-=(std::chrono::days days) noexcept;
+
+    [[nodiscard]] friend constexpr Date operator+(Date date, std::chrono::days days) noexcept { return date += days; }
+    [[nodiscard]] friend constexpr Date operator+(std::chrono::days days, Date date) noexcept { return date += days; }
+    [[nodiscard]] friend constexpr Date operator-(Date date, std::chrono::days days) noexcept { return date -= days; }
+
+    /**
+     * @brief Calculates the signed number of days from one date to another.
+     *
+     * @return The duration from rhs to lhs (negative if lhs is earlier).
+     */
+    [[nodiscard]] friend constexpr std::chrono::days operator-(const Date& lhs, const Date& rhs) noexcept {
+        return std::chrono::days{ lhs.ToDays() - rhs.ToDays() };
+    }
+
+
     // ========= Static functions: ========= //
     /**
      * @brief Counts the number of leap years up to a given date.
@@ -61,7 +143,7 @@ public:
      * @param date The date up to which to count leap years.
      * @return The count of leap years.
      */
-    static std::size_t CountLeapYears(const Date& date);
+    static constexpr std::size_t CountLeapYears(const Date& date);
 
     /**
      * @brief Calculates the difference in days between two Date objects.
@@ -69,11 +151,55 @@ public:
      * @param first The first Date object.
      * @param second The second Date object.
      * @return The difference in days between the two dates.
-     * @note The difference is calculated using the total number of days from year 0.
-     * This means that the difference is always positive.
+     * @note The difference is calculated from the serial day numbers of the dates in constant time.
+     * The difference is always positive.
+     */
+    [[nodiscard]] static constexpr std::size_t Difference(const Date& first, const Date& second) noexcept;
+
+
+    /**
+     * @brief Converts a date to its serial day number in constant time.
+     *
+     * @param year The year of the date.
+     * @param month The month of the date (1-12).
+     * @param day The day of the date.
+     * @return The number of days since 1970/1/1 (negative for earlier dates).
+     * @note Based on Howard Hinnant's days_from_civil algorithm (proleptic Gregorian calendar).
      */
-    [[nodiscard]] static std::size_t Difference(const Date& first, const Date& second) noexcept;
+    [[nodiscard]] static constexpr std::int64_t DaysFromCivil(int year, unsigned month, unsigned day) noexcept;
 
+    /**
+     * @brief Converts a serial day number back to a date in constant time.
+     *
+     * @param days The number of days since 1970/1/1.
+     * @return The corresponding date.
+     * @note Based on Howard Hinnant's civil_from_days algorithm (proleptic Gregorian calendar).
+     */
+    [[nodiscard]] static constexpr Date CivilFromDays(std::int64_t days) noexcept;
+
+    /**
+     * @brief Converts std::chrono calendar types to a Date without validation.
+     *
+     * @param date A valid std::chrono::year_month_day (ok() is true), or any std::chrono::sys_days.
+     * @return The equivalent date.
+     * @note Unlike the constructor, FromYearMonthDay does not check the day against the month.
+     */
+    [[nodiscard]] static constexpr Date FromYearMonthDay(const std::chrono::year_month_day& date) noexcept;
+    [[nodiscard]] static constexpr Date FromSysDays(std::chrono::sys_days date) noexcept;
+
+    /**
+     * @brief Parses a date from a character range.
+     *
+     * Accepts "YYYY-MM-DD", "YYYY/MM/DD" and the compact "YYYYMMDD" (4-digit years), and the
+     * expanded years written by ToChars: a sign and at least four digits ("+12345-01-01", "-0101/01/02").
+     *
+     * @param first The beginning of the range.
+     * @param last The end of the range.
+     * @param value Receives the parsed date (unchanged on error).
+     * @return ptr points past the parsed characters; ec is std::errc::invalid_argument
+     * if the range does not start with a valid date.
+     */
+    static std::from_chars_result FromChars(const char* first, const char* last, Date& value) noexcept;
 
     /**
      * @brief Retrieves the number of days in a specific month of a given year.
@@ -82,7 +208,7 @@ public:
      * @param month The month of the date.
      * @return The number of days in the specified month.
      */
-    static unsigned DaysInMonth(int year, unsigned month);
+    static constexpr unsigned DaysInMonth(int year, unsigned month);
 
     /**
      * @brief Checks if a given year is a leap year.
@@ -90,7 +216,7 @@ public:
      * @param year The year to check.
      * @return True if the year is a leap year, false otherwise.
      */
-    static bool IsLeapYear(int year);
+    static constexpr bool IsLeapYear(int year);
 
     /**
      * @brief Calculates the day of the year for a given date.
@@ -98,7 +224,36 @@ public:
      * @param date The Date object for which to calculate the day of the year.
      * @return The day of the year.
      */
-    static unsigned DayOfYear(const Date& date);
+    static constexpr unsigned DayOfYear(const Date& date);
+
+    /**
+     * @brief Calculates the day of the year for a given year, month and day.
+     *
+     * @param year The year of the date.
+     * @param month The month of the date (1-12).
+     * @param day The day of the date.
+     * @return The day of the year.
+     */
+    static constexpr unsigned DayOfYear(int year, unsigned month, unsigned day);
+
+    /**
+     * @brief Adds months to a year and month in place, clamping the day to the resulting month.
+     *
+     * @param year The year of the date.
+     * @param month The month of the date (1-12).
+     * @param day The day of the date.
+     * @param numMonths The number of months to add (negative to subtract).
+     * @note Used by AddMonths and AddYears, and by their batch versions.
+     */
+    static constexpr void ShiftMonths(int& year, unsigned& month, unsigned& day, std::int64_t numMonths) noexcept;
+
+    /**
+     * @brief Calculates the day of the week for a given date.
+     *
+     * @param date The Date object for which to calculate the day of the week.
+     * @return The ISO day of the week (1 = Monday, ..., 7 = Sunday).
+     */
+    static constexpr unsigned DayOfWeek(const Date& date);
 
 
     // ========= I/O friend operators: ========= //
@@ -113,9 +268,176 @@ public:
 
 
 private:
+    // Tag for the constructor that skips validation of already valid components.
+    struct Unchecked {};
+
+    constexpr Date(int year, unsigned month, unsigned day, Unchecked) noexcept;
+
+    // Number of days in each month of a non-leap year.
+    static constexpr std::array<unsigned, 12> DAYS_IN_MONTH_{ 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+
+    // Number of days before the first day of each month, for non-leap and leap years.
+    static constexpr std::array<std::array<unsigned, 12>, 2> CUMULATIVE_DAYS_{ {
+        { 0, 31, 59, 90, 120, 151, 181, 212, 243, 273, 304, 334 },
+        { 0, 31, 60, 91, 121, 152, 182, 213, 244, 274, 305, 335 },
+    } };
+
     int year_;
     unsigned month_;
     unsigned day_;
 };
 
+
+// Everything below is constexpr, so dates known at compile time fold into constants
+// (and invalid literal dates fail to compile).
+constexpr Date::Date(int year, unsigned month, unsigned day)
+    : year_{ year }, month_{ month }, day_{ day } {
+    if(month_ < 1 || month_ > 12)
+        throw std::invalid_argument("Invalid month.");
+    if(day_ < 1 || day_ > DaysInMonth(year_, month_))
+        throw std::invalid_argument("Invalid day.");
+}
+
+constexpr Date::Date(int year, unsigned month, unsigned day, Unchecked) noexcept
+    : year_{ year }, month_{ month }, day_{ day } {}
+
+constexpr void Date::AddDays(unsigned numDays) noexcept {
+    *this = CivilFromDays(ToDays() + numDays);
+}
+
+constexpr void Date::SubtractDays(std::int64_t numDays) noexcept {
+    *this = CivilFromDays(ToDays() - numDays);
+}
+
+constexpr void Date::AddMonths(int numMonths) noexcept {
+    ShiftMonths(year_, month_, day_, numMonths);
+}
+
+constexpr void Date::AddYears(int numYears) noexcept {
+    ShiftMonths(year_, month_, day_, static_cast<std::int64_t>(numYears) * 12);
+}
+
+[[nodiscard]] constexpr int Date::Year() const noexcept {
+    return year_;
+}
+
+[[nodiscard]] constexpr unsigned Date::Month() const noexcept {
+    return month_;
+}
+
+[[nodiscard]] constexpr unsigned Date::Day() const noexcept {
+    return day_;
+}
+
+[[nodiscard]] constexpr std::int64_t Date::ToDays() const noexcept {
+    return DaysFromCivil(year_, month_, day_);
+}
+
+[[nodiscard]] constexpr std::chrono::year_month_day Date::ToYearMonthDay() const {
+    if(year_ < static_cast<int>(std::chrono::year::min()) || year_ > static_cast<int>(std::chrono::year::max()))
+        throw std::out_of_range("Year does not fit std::chrono::year.");
+
+    return std::chrono::year_month_day{ std::chrono::year{ year_ }, std::chrono::month{ month_ }, std::chrono::day{ day_ } };
+}
+
+[[nodiscard]] constexpr std::chrono::sys_days Date::ToSysDays() const noexcept {
+    return std::chrono::sys_days{ std::chrono::days{ ToDays() } };
+}
+
+constexpr Date& Date::operator+=(std::chrono::days days) noexcept {
+    return *this = CivilFromDays(ToDays() + days.count());
+}
+
+constexpr Date& Date::operator-=(std::chrono::days days) noexcept {
+    return *this = CivilFromDays(ToDays() - days.count());
+}
+
+constexpr std::size_t Date::CountLeapYears(const Date& date) {
+    std::size_t years{ static_cast<std::size_t>(date.Year()) };
+    if(date.Month() <= 2)
+        years--;
+
+    // An year is a leap year if it is:
+    // 1. a multiple of 4,
+    // 2. multiple of 400
+    // 3. and not a multiple of 100.
+    return years / 4 - years / 100 + years / 400;
+}
+
+constexpr std::size_t Date::Difference(const Date& first, const Date& second) noexcept {
+    const std::int64_t daysInFirstDate{ first.ToDays() };
+    const std::int64_t daysInSecondDate{ second.ToDays() };
+
+    // Calculate the difference in days between the two dates.
+    return static_cast<std::size_t>(std::max(daysInFirstDate, daysInSecondDate) - std::min(daysInFirstDate, daysInSecondDate));
+}
+
+constexpr unsigned Date::DaysInMonth(int year, unsigned month) {
+    // It it's February, check if it's a leap year.
+    if(month == 2)
+        return IsLeapYear(year) ? 29 : 28;
+
+    return DAYS_IN_MONTH_[month - 1];
+}
+
+constexpr bool Date::IsLeapYear(int year) {
+    return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+}
+
+constexpr unsigned Date::DayOfYear(const Date& date) {
+    return DayOfYear(date.year_, date.month_, date.day_);
+}
+
+constexpr unsigned Date::DayOfYear(int year, unsigned month, unsigned day) {
+    return CUMULATIVE_DAYS_[IsLeapYear(year)][month - 1] + day;
+}
+
+constexpr void Date::ShiftMonths(int& year, unsigned& month, unsigned& day, std::int64_t numMonths) noexcept {
+    // Count months from year 0 and split back with floor division.
+    const std::int64_t months{ static_cast<std::int64_t>(year) * 12 + (month - 1) + numMonths };
+    const std::int64_t floorYear{ (months >= 0 ? months : months - 11) / 12 };
+    year = static_cast<int>(floorYear);
+    month = static_cast<unsigned>(months - floorYear * 12 + 1);
+    day = std::min(day, DaysInMonth(year, month));
+}
+
+constexpr unsigned Date::DayOfWeek(const Date& date) {
+    // 1970/1/1 was a Thursday (4); the remainder is kept non-negative for earlier dates.
+    const std::int64_t days{ date.ToDays() };
+    const std::int64_t weekday{ days >= -3 ? (days + 3) % 7 : (days + 4) % 7 + 6 };  // 0 = Monday.
+    return static_cast<unsigned>(weekday) + 1;
+}
+
+constexpr std::int64_t Date::DaysFromCivil(int year, unsigned month, unsigned day) noexcept {
+    // The computation uses years starting on March 1st, so February is the last month
+    // and the leap day does not affect the day of year of the other months.
+    const std::int64_t y{ static_cast<std::int64_t>(year) - (month <= 2) };
+    const std::int64_t era{ (y >= 0 ? y : y - 399) / 400 };
+    const std::int64_t yearOfEra{ y - era * 400 };                                                  // [0, 399].
+    const std::int64_t dayOfYear{ (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1 };  // [0, 365].
+    const std::int64_t dayOfEra{ yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear };   // [0, 146096].
+    return era * 146097 + dayOfEra - 719468;
+}
+
+constexpr Date Date::CivilFromDays(std::int64_t days) noexcept {
+    days += 719468;  // Shift the epoch from 1970/1/1 to 0000/3/1.
+    const std::int64_t era{ (days >= 0 ? days : days - 146096) / 146097 };
+    const std::int64_t dayOfEra{ days - era * 146097 };                                                          // [0, 146096].
+    const std::int64_t yearOfEra{ (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365 };  // [0, 399].
+    const std::int64_t dayOfYear{ dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100) };             // [0, 365].
+    const std::int64_t monthIndex{ (5 * dayOfYear + 2) / 153 };                                                  // [0, 11], from March.
+    const unsigned day{ static_cast<unsigned>(dayOfYear - (153 * monthIndex + 2) / 5 + 1) };
+    const unsigned month{ static_cast<unsigned>(monthIndex < 10 ? monthIndex + 3 : monthIndex - 9) };
+    const int year{ static_cast<int>(yearOfEra + era * 400 + (month <= 2)) };
+    return Date{ year, month, day, Unchecked{} };
+}
+
+constexpr Date Date::FromYearMonthDay(const std::chrono::year_month_day& date) noexcept {
+    return Date{ static_cast<int>(date.year()), static_cast<unsigned>(date.month()), static_cast<unsigned>(date.day()), Unchecked{} };
+}
+
+constexpr Date Date::FromSysDays(std::chrono::sys_days date) noexcept {
+    return CivilFromDays(date.time_since_epoch().count());
+}
+
 }  // namespace setm
@@ -0,0 +1,265 @@
+#include "date_codec.hpp"
+
+#include <algorithm>  // std::max, std::min, std::minmax_element.
+#include <bit>        // std::bit_width.
+#include <cstddef>    // std::size_t.
+#include <cstdint>    // std::int64_t, std::uint64_t, std::uint8_t.
+#include <istream>    // std::istream.
+#include <limits>     // std::numeric_limits.
+#include <ostream>    // std::ostream.
+#include <span>       // std::span.
+#include <stdexcept>  // std::logic_error, std::runtime_error.
+#include <vector>     // std::vector.
+
+#include "date.hpp"         // setm::Date.
+#include "date_column.hpp"  // setm::DateColumn.
+
+namespace setm {
+
+namespace {
+
+// File header: format name and version.
+constexpr unsigned char MAGIC[4]{ 'S', 'D', 'C', 1 };
+
+// Block header: count (4 bytes), width (1), min (8), max (8), first (8), payload size (4).
+constexpr std::size_t BLOCK_HEADER_SIZE{ 33 };
+
+// Zero bytes after a payload, so the unpacker can always load 9 bytes at once.
+constexpr std::size_t PADDING{ 16 };
+
+void StoreLittleEndian(unsigned char* out, std::uint64_t value, std::size_t bytes) noexcept {
+    for(std::size_t i{}; i < bytes; ++i)
+        out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+std::uint64_t LoadLittleEndian(const unsigned char* in, std::size_t bytes) noexcept {
+    std::uint64_t value{};
+    for(std::size_t i{}; i < bytes; ++i)
+        value |= static_cast<std::uint64_t>(in[i]) << (8 * i);
+    return value;
+}
+
+// Maps signed differences to unsigned values with small magnitudes first (0, -1, 1, -2, ...).
+constexpr std::uint64_t ZigZag(std::int64_t value) noexcept {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+constexpr std::int64_t UnZigZag(std::uint64_t value) noexcept {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+std::size_t PayloadSize(std::size_t count, unsigned width) noexcept {
+    return ((count - 1) * width + 7) / 8;
+}
+
+// Reads width bits starting at a bit offset (the payload must be padded).
+std::uint64_t Extract(const unsigned char* data, std::size_t bit, unsigned width, std::uint64_t mask) noexcept {
+    const std::size_t byte{ bit / 8 };
+    const unsigned shift{ static_cast<unsigned>(bit % 8) };
+    std::uint64_t value{ LoadLittleEndian(data + byte, 8) >> shift };
+    if(shift + width > 64)
+        value |= static_cast<std::uint64_t>(data[byte + 8]) << (64 - shift);
+    return value & mask;
+}
+
+// Decodes count days from the packed differences; eight values are unpacked per iteration.
+void Unpack(const unsigned char* data, unsigned width, std::size_t count, std::int64_t first, std::int64_t* out) noexcept {
+    const std::uint64_t mask{ width == 64 ? std::numeric_limits<std::uint64_t>::max() : (std::uint64_t{ 1 } << width) - 1 };
+    const std::size_t deltas{ count - 1 };
+    std::uint64_t previous{ static_cast<std::uint64_t>(first) };  // Unsigned, so corrupted input wraps instead of overflowing.
+    out[0] = first;
+
+    std::size_t i{};
+    for(; i + 8 <= deltas; i += 8) {
+        std::uint64_t values[8];
+        for(std::size_t j{}; j < 8; ++j)
+            values[j] = Extract(data, (i + j) * width, width, mask);
+        for(std::size_t j{}; j < 8; ++j) {
+            previous += static_cast<std::uint64_t>(UnZigZag(values[j]));
+            out[i + j + 1] = static_cast<std::int64_t>(previous);
+        }
+    }
+    for(; i < deltas; ++i) {
+        previous += static_cast<std::uint64_t>(UnZigZag(Extract(data, i * width, width, mask)));
+        out[i + 1] = static_cast<std::int64_t>(previous);
+    }
+}
+
+}  // Anonymous namespace.
+
+DateColumnEncoder::DateColumnEncoder(std::ostream& out)
+    : out_{ out } {
+    pending_.reserve(BLOCK_SIZE);
+    out_.write(reinterpret_cast<const char*>(MAGIC), sizeof(MAGIC));
+    if(!out_)
+        throw std::runtime_error("Cannot write the date column.");
+    bytesWritten_ = sizeof(MAGIC);
+}
+
+void DateColumnEncoder::Write(const Date& date) {
+    Append(date.ToDays());
+}
+
+void DateColumnEncoder::Write(std::span<const Date> dates) {
+    for(const Date& date : dates)
+        Append(date.ToDays());
+}
+
+void DateColumnEncoder::Write(const DateColumn& dates) {
+    const std::span<const int> years{ dates.Years() };
+    const std::span<const std::uint8_t> months{ dates.Months() };
+    const std::span<const std::uint8_t> days{ dates.Days() };
+    for(std::size_t i{}; i < dates.Size(); ++i)
+        Append(Date::DaysFromCivil(years[i], months[i], days[i]));
+}
+
+void DateColumnEncoder::Finish() {
+    if(finished_)
+        return;
+    FlushBlock();
+    out_.flush();
+    if(!out_)
+        throw std::runtime_error("Cannot write the date column.");
+    finished_ = true;
+}
+
+[[nodiscard]] std::size_t DateColumnEncoder::BytesWritten() const noexcept {
+    return bytesWritten_;
+}
+
+void DateColumnEncoder::Append(std::int64_t days) {
+    if(finished_)
+        throw std::logic_error("The date column has already been finished.");
+
+    pending_.push_back(days);
+    if(pending_.size() == BLOCK_SIZE)
+        FlushBlock();
+}
+
+void DateColumnEncoder::FlushBlock() {
+    const std::size_t count{ pending_.size() };
+    if(count == 0)
+        return;
+
+    // Differences wrap around in unsigned arithmetic, so any pair of days is representable.
+    std::vector<std::uint64_t> deltas(count - 1);
+    std::uint64_t bits{};
+    for(std::size_t i{ 1 }; i < count; ++i) {
+        deltas[i - 1] = ZigZag(static_cast<std::int64_t>(static_cast<std::uint64_t>(pending_[i]) - static_cast<std::uint64_t>(pending_[i - 1])));
+        bits |= deltas[i - 1];
+    }
+    const unsigned width{ static_cast<unsigned>(std::bit_width(bits)) };
+    const auto [min, max]{ std::minmax_element(pending_.begin(), pending_.end()) };
+
+    const std::size_t payloadSize{ PayloadSize(count, width) };
+    std::vector<unsigned char> block(BLOCK_HEADER_SIZE + payloadSize + PADDING);
+    StoreLittleEndian(block.data(), count, 4);
+    block[4] = static_cast<unsigned char>(width);
+    StoreLittleEndian(block.data() + 5, static_cast<std::uint64_t>(*min), 8);
+    StoreLittleEndian(block.data() + 13, static_cast<std::uint64_t>(*max), 8);
+    StoreLittleEndian(block.data() + 21, static_cast<std::uint64_t>(pending_.front()), 8);
+    StoreLittleEndian(block.data() + 29, payloadSize, 4);
+
+    unsigned char* const payload{ block.data() + BLOCK_HEADER_SIZE };
+    for(std::size_t i{}; i < deltas.size() && width > 0; ++i) {
+        const std::size_t bit{ i * width };
+        const unsigned shift{ static_cast<unsigned>(bit % 8) };
+        const std::uint64_t low{ LoadLittleEndian(payload + bit / 8, 8) | deltas[i] << shift };
+        StoreLittleEndian(payload + bit / 8, low, 8);
+        if(shift + width > 64)
+            payload[bit / 8 + 8] |= static_cast<unsigned char>(deltas[i] >> (64 - shift));
+    }
+
+    out_.write(reinterpret_cast<const char*>(block.data()), static_cast<std::streamsize>(BLOCK_HEADER_SIZE + payloadSize));
+    if(!out_)
+        throw std::runtime_error("Cannot write the date column.");
+    bytesWritten_ += BLOCK_HEADER_SIZE + payloadSize;
+    pending_.clear();
+}
+
+DateColumnReader::DateColumnReader(std::istream& in)
+    : in_{ in } {
+    unsigned char magic[sizeof(MAGIC)]{};
+    in_.read(reinterpret_cast<char*>(magic), sizeof(magic));
+    if(!in_ || !std::equal(std::begin(magic), std::end(magic), std::begin(MAGIC)))
+        throw std::runtime_error("Not a date column.");
+    bytesRead_ = sizeof(MAGIC);
+}
+
+bool DateColumnReader::ReadBlock(std::vector<std::int64_t>& days) {
+    return NextBlock(std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(), days);
+}
+
+[[nodiscard]] DateColumn DateColumnReader::ReadAll() {
+    DateColumn column;
+    std::vector<std::int64_t> days;
+    while(ReadBlock(days)) {
+        column.Reserve(column.Size() + days.size());
+        for(const std::int64_t day : days)
+            column.PushBack(Date::CivilFromDays(day));
+    }
+    return column;
+}
+
+[[nodiscard]] DateColumn DateColumnReader::ReadRange(const Date& from, const Date& to) {
+    const std::int64_t first{ from.ToDays() };
+    const std::int64_t last{ to.ToDays() };
+    DateColumn column;
+    std::vector<std::int64_t> days;
+    while(NextBlock(first, last, days)) {
+        for(const std::int64_t day : days) {
+            if(day >= first && day < last)
+                column.PushBack(Date::CivilFromDays(day));
+        }
+    }
+    return column;
+}
+
+[[nodiscard]] std::size_t DateColumnReader::BytesRead() const noexcept {
+    return bytesRead_;
+}
+
+[[nodiscard]] std::size_t DateColumnReader::BlocksSkipped() const noexcept {
+    return blocksSkipped_;
+}
+
+bool DateColumnReader::NextBlock(std::int64_t from, std::int64_t to, std::vector<std::int64_t>& days) {
+    while(true) {
+        unsigned char header[BLOCK_HEADER_SIZE];
+        in_.read(reinterpret_cast<char*>(header), BLOCK_HEADER_SIZE);
+        if(in_.gcount() == 0 && in_.eof())
+            return false;
+        if(static_cast<std::size_t>(in_.gcount()) != BLOCK_HEADER_SIZE)
+            throw std::runtime_error("Truncated date column block.");
+        bytesRead_ += BLOCK_HEADER_SIZE;
+
+        const std::size_t count{ static_cast<std::size_t>(LoadLittleEndian(header, 4)) };
+        const unsigned width{ header[4] };
+        const std::int64_t min{ static_cast<std::int64_t>(LoadLittleEndian(header + 5, 8)) };
+        const std::int64_t max{ static_cast<std::int64_t>(LoadLittleEndian(header + 13, 8)) };
+        const std::int64_t first{ static_cast<std::int64_t>(LoadLittleEndian(header + 21, 8)) };
+        const std::size_t payloadSize{ static_cast<std::size_t>(LoadLittleEndian(header + 29, 4)) };
+        if(count == 0 || count > DateColumnEncoder::BLOCK_SIZE || width > 64 || payloadSize != PayloadSize(count, width))
+            throw std::runtime_error("Corrupted date column block.");
+
+        if(max < from || min >= to) {
+            in_.seekg(static_cast<std::streamoff>(payloadSize), std::ios::cur);
+            if(!in_)
+                throw std::runtime_error("Truncated date column block.");
+            ++blocksSkipped_;
+            continue;
+        }
+
+        payload_.assign(payloadSize + PADDING, 0);
+        in_.read(reinterpret_cast<char*>(payload_.data()), static_cast<std::streamsize>(payloadSize));
+        if(static_cast<std::size_t>(in_.gcount()) != payloadSize)
+            throw std::runtime_error("Truncated date column block.");
+        bytesRead_ += payloadSize;
+
+        days.resize(count);
+        Unpack(payload_.data(), width, count, first, days.data());
+        return true;
+    }
+}
+
+}  // namespace setm
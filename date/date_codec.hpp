@@ -0,0 +1,138 @@
+#pragma once
+
+#include <cstddef>  // std::size_t.
+#include <cstdint>  // std::int64_t.
+#include <istream>  // std::istream.
+#include <ostream>  // std::ostream.
+#include <span>     // std::span.
+#include <vector>   // std::vector.
+
+#include "date.hpp"         // setm::Date.
+#include "date_column.hpp"  // setm::DateColumn.
+
+namespace setm {
+
+/**
+ * @brief Writes dates in a compressed columnar format.
+ *
+ * Dates are stored as serial day numbers in blocks of up to BLOCK_SIZE values. Every block
+ * starts with a header (number of values, bit width, smallest and largest day, first day and
+ * payload size), followed by the zig-zag encoded differences between consecutive days,
+ * bit-packed at the block's width. Sorted or clustered dates take a few bits each.
+ * All integers are little-endian.
+ */
+class DateColumnEncoder {
+public:
+    // Maximum number of dates per block.
+    static constexpr std::size_t BLOCK_SIZE{ 1024 };
+
+    // ========= Constructors: ========= //
+    /**
+     * @brief Starts a column on a stream (writes the file header).
+     *
+     * @param out The stream to write to (opened in binary mode).
+     * @throws std::runtime_error if the stream fails.
+     */
+    explicit DateColumnEncoder(std::ostream& out);
+
+    DateColumnEncoder(const DateColumnEncoder&) = delete;
+    DateColumnEncoder& operator=(const DateColumnEncoder&) = delete;
+
+
+    // ========= Methods: ========= //
+    /**
+     * @brief Appends dates to the column; full blocks are written immediately.
+     *
+     * @param date The date(s) to append.
+     * @throws std::logic_error if Finish() has been called.
+     * @throws std::runtime_error if the stream fails.
+     */
+    void Write(const Date& date);
+    void Write(std::span<const Date> dates);
+    void Write(const DateColumn& dates);
+
+    /**
+     * @brief Writes the last (partial) block. Must be called once all dates have been written.
+     *
+     * @throws std::runtime_error if the stream fails.
+     */
+    void Finish();
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] std::size_t BytesWritten() const noexcept;
+
+
+private:
+    void Append(std::int64_t days);
+    void FlushBlock();
+
+    std::ostream& out_;
+    std::vector<std::int64_t> pending_;  // Serial day numbers of the current block.
+    std::size_t bytesWritten_{};
+    bool finished_{ false };
+};
+
+/**
+ * @brief Reads dates written by DateColumnEncoder.
+ *
+ * Blocks whose range of dates does not overlap the requested range are skipped
+ * without being read or decoded, using the smallest and largest day of their header.
+ */
+class DateColumnReader {
+public:
+    // ========= Constructors: ========= //
+    /**
+     * @brief Starts reading a column from a stream (checks the file header).
+     *
+     * @param in The stream to read from (opened in binary mode).
+     * @throws std::runtime_error if the stream does not hold a date column.
+     */
+    explicit DateColumnReader(std::istream& in);
+
+
+    // ========= Methods: ========= //
+    /**
+     * @brief Decodes the next block.
+     *
+     * @param days Receives the serial day numbers of the block (replacing its contents).
+     * @return False if there are no more blocks.
+     * @throws std::runtime_error if the block is truncated or corrupted.
+     */
+    bool ReadBlock(std::vector<std::int64_t>& days);
+
+    /**
+     * @brief Reads all remaining dates.
+     *
+     * @return The dates, in the order they were written.
+     * @throws std::runtime_error if a block is truncated or corrupted.
+     */
+    [[nodiscard]] DateColumn ReadAll();
+
+    /**
+     * @brief Reads the remaining dates in [from, to), skipping the blocks outside of the range.
+     *
+     * @param from The first date.
+     * @param to The date after the last one.
+     * @return The dates in the range, in the order they were written.
+     * @throws std::runtime_error if a block is truncated or corrupted.
+     */
+    [[nodiscard]] DateColumn ReadRange(const Date& from, const Date& to);
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] std::size_t BytesRead() const noexcept;
+    [[nodiscard]] std::size_t BlocksSkipped() const noexcept;
+
+
+private:
+    // Reads blocks until one overlaps [from, to); returns false at the end of the column.
+    bool NextBlock(std::int64_t from, std::int64_t to, std::vector<std::int64_t>& days);
+
+    std::istream& in_;
+    std::vector<unsigned char> payload_;  // Buffer for the packed values of a block.
+    std::size_t bytesRead_{};
+    std::size_t blocksSkipped_{};
+};
+
+}  // namespace setm
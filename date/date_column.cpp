@@ -0,0 +1,268 @@
+#include "date_column.hpp"
+
+#include <algorithm>     // std::max, std::min.
+#include <charconv>      // std::from_chars_result.
+#include <cstddef>       // std::size_t.
+#include <cstdint>       // std::int64_t, std::uint8_t.
+#include <filesystem>    // std::filesystem::path.
+#include <fstream>       // std::ifstream.
+#include <span>          // std::span.
+#include <stdexcept>     // std::invalid_argument, std::runtime_error.
+#include <string>        // std::string, std::to_string.
+#include <string_view>   // std::string_view.
+#include <system_error>  // std::errc.
+#include <thread>        // std::thread.
+#include <utility>       // std::move.
+#include <vector>        // std::vector.
+
+#include "date.hpp"      // setm::Date.
+#include "parallel.hpp"  // setm::detail::ParallelFor.
+
+namespace setm {
+
+namespace {
+
+using detail::PARALLEL_THRESHOLD;
+using detail::ParallelFor;
+
+void CheckSizes(std::size_t lhs, std::size_t rhs) {
+    if(lhs != rhs)
+        throw std::invalid_argument("Batch arguments have different sizes.");
+}
+
+// Date::ShiftMonths on one row of a DateColumn.
+void ShiftMonths(int& year, std::uint8_t& month, std::uint8_t& day, std::int64_t numMonths) noexcept {
+    unsigned shiftedMonth{ month };
+    unsigned shiftedDay{ day };
+    Date::ShiftMonths(year, shiftedMonth, shiftedDay, numMonths);
+    month = static_cast<std::uint8_t>(shiftedMonth);
+    day = static_cast<std::uint8_t>(shiftedDay);
+}
+
+// Parses the lines of text into column. Returns the offset of the first invalid line, or npos.
+std::size_t ParseLines(std::string_view text, DateColumn& column) {
+    const char* const begin{ text.data() };
+    const char* const end{ begin + text.size() };
+    const char* current{ begin };
+    while(current < end) {
+        if(*current == '\n' || *current == '\r') {
+            ++current;
+            continue;
+        }
+
+        Date date{ Date::CivilFromDays(0) };
+        const std::from_chars_result result{ Date::FromChars(current, end, date) };
+        if(result.ec != std::errc{} || (result.ptr < end && *result.ptr != '\n' && *result.ptr != '\r'))
+            return static_cast<std::size_t>(current - begin);
+
+        column.PushBack(date);
+        current = result.ptr;
+    }
+    return std::string_view::npos;
+}
+
+}  // Anonymous namespace.
+
+DateColumn::DateColumn(std::span<const Date> dates) {
+    Reserve(dates.size());
+    for(const Date& date : dates)
+        PushBack(date);
+}
+
+void DateColumn::PushBack(const Date& date) {
+    years_.push_back(date.Year());
+    months_.push_back(static_cast<std::uint8_t>(date.Month()));
+    days_.push_back(static_cast<std::uint8_t>(date.Day()));
+}
+
+void DateColumn::Reserve(std::size_t capacity) {
+    years_.reserve(capacity);
+    months_.reserve(capacity);
+    days_.reserve(capacity);
+}
+
+[[nodiscard]] std::size_t DateColumn::Size() const noexcept {
+    return years_.size();
+}
+
+[[nodiscard]] std::span<const int> DateColumn::Years() const noexcept {
+    return years_;
+}
+
+[[nodiscard]] std::span<const std::uint8_t> DateColumn::Months() const noexcept {
+    return months_;
+}
+
+[[nodiscard]] std::span<const std::uint8_t> DateColumn::Days() const noexcept {
+    return days_;
+}
+
+[[nodiscard]] Date DateColumn::operator[](std::size_t index) const {
+    return Date{ years_[index], months_[index], days_[index] };
+}
+
+DateColumn DateColumn::Parse(std::string_view text) {
+    // Split the text into chunks that start at line boundaries.
+    const std::size_t maxThreads{ std::max(1u, std::thread::hardware_concurrency()) };
+    const std::size_t threads{ std::max<std::size_t>(1, std::min(maxThreads, text.size() / (PARALLEL_THRESHOLD * 16))) };
+    std::vector<std::size_t> bounds{ 0 };
+    for(std::size_t i{ 1 }; i < threads; ++i) {
+        const std::size_t newline{ text.find('\n', std::max(bounds.back(), text.size() * i / threads)) };
+        if(newline == std::string_view::npos)
+            break;
+        bounds.push_back(newline + 1);
+    }
+    bounds.push_back(text.size());
+
+    const std::size_t chunks{ bounds.size() - 1 };
+    std::vector<DateColumn> columns(chunks);
+    std::vector<std::size_t> errors(chunks, std::string_view::npos);
+    const auto parseChunk{ [&](std::size_t chunk) {
+        const std::string_view part{ text.substr(bounds[chunk], bounds[chunk + 1] - bounds[chunk]) };
+        columns[chunk].Reserve(part.size() / 11 + 1);
+        errors[chunk] = ParseLines(part, columns[chunk]);
+    } };
+
+    std::vector<std::thread> pool;
+    for(std::size_t chunk{ 1 }; chunk < chunks; ++chunk)
+        pool.emplace_back(parseChunk, chunk);
+    parseChunk(0);
+    for(std::thread& thread : pool)
+        thread.join();
+
+    for(std::size_t chunk{}; chunk < chunks; ++chunk) {
+        if(errors[chunk] != std::string_view::npos)
+            throw std::invalid_argument("Invalid date at offset " + std::to_string(bounds[chunk] + errors[chunk]) + ".");
+    }
+
+    if(chunks == 1)
+        return std::move(columns.front());
+
+    DateColumn column;
+    std::size_t size{};
+    for(const DateColumn& part : columns)
+        size += part.Size();
+    column.Reserve(size);
+    for(const DateColumn& part : columns) {
+        column.years_.insert(column.years_.end(), part.years_.begin(), part.years_.end());
+        column.months_.insert(column.months_.end(), part.months_.begin(), part.months_.end());
+        column.days_.insert(column.days_.end(), part.days_.begin(), part.days_.end());
+    }
+    return column;
+}
+
+DateColumn DateColumn::ReadFile(const std::filesystem::path& path) {
+    std::ifstream file{ path, std::ios::binary | std::ios::ate };
+    if(!file)
+        throw std::runtime_error("Cannot open " + path.string() + ".");
+
+    // Read the whole file in one call, then parse it in place.
+    std::string text(static_cast<std::size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if(!file.read(text.data(), static_cast<std::streamsize>(text.size())))
+        throw std::runtime_error("Cannot read " + path.string() + ".");
+
+    return Parse(text);
+}
+
+void AddDays(std::span<Date> dates, std::span<const int> numDays) {
+    CheckSizes(dates.size(), numDays.size());
+    ParallelFor(dates.size(), [dates, numDays](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            dates[i] = Date::CivilFromDays(dates[i].ToDays() + numDays[i]);
+    });
+}
+
+void AddDays(DateColumn& dates, std::span<const int> numDays) {
+    CheckSizes(dates.Size(), numDays.size());
+    int* const years{ dates.years_.data() };
+    std::uint8_t* const months{ dates.months_.data() };
+    std::uint8_t* const days{ dates.days_.data() };
+    ParallelFor(dates.Size(), [=](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i) {
+            const Date date{ Date::CivilFromDays(Date::DaysFromCivil(years[i], months[i], days[i]) + numDays[i]) };
+            years[i] = date.Year();
+            months[i] = static_cast<std::uint8_t>(date.Month());
+            days[i] = static_cast<std::uint8_t>(date.Day());
+        }
+    });
+}
+
+void AddMonths(std::span<Date> dates, std::span<const int> numMonths) {
+    CheckSizes(dates.size(), numMonths.size());
+    ParallelFor(dates.size(), [dates, numMonths](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            dates[i].AddMonths(numMonths[i]);
+    });
+}
+
+void AddMonths(DateColumn& dates, std::span<const int> numMonths) {
+    CheckSizes(dates.Size(), numMonths.size());
+    int* const years{ dates.years_.data() };
+    std::uint8_t* const months{ dates.months_.data() };
+    std::uint8_t* const days{ dates.days_.data() };
+    ParallelFor(dates.Size(), [=](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            ShiftMonths(years[i], months[i], days[i], numMonths[i]);
+    });
+}
+
+void AddYears(std::span<Date> dates, std::span<const int> numYears) {
+    CheckSizes(dates.size(), numYears.size());
+    ParallelFor(dates.size(), [dates, numYears](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            dates[i].AddYears(numYears[i]);
+    });
+}
+
+void AddYears(DateColumn& dates, std::span<const int> numYears) {
+    CheckSizes(dates.Size(), numYears.size());
+    int* const years{ dates.years_.data() };
+    std::uint8_t* const months{ dates.months_.data() };
+    std::uint8_t* const days{ dates.days_.data() };
+    ParallelFor(dates.Size(), [=](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            ShiftMonths(years[i], months[i], days[i], static_cast<std::int64_t>(numYears[i]) * 12);
+    });
+}
+
+void Difference(std::span<const Date> first, std::span<const Date> second, std::span<std::int64_t> out) {
+    CheckSizes(first.size(), second.size());
+    CheckSizes(first.size(), out.size());
+    ParallelFor(out.size(), [first, second, out](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i) {
+            const std::int64_t difference{ second[i].ToDays() - first[i].ToDays() };
+            out[i] = difference < 0 ? -difference : difference;
+        }
+    });
+}
+
+void Difference(const DateColumn& first, const DateColumn& second, std::span<std::int64_t> out) {
+    CheckSizes(first.Size(), second.Size());
+    CheckSizes(first.Size(), out.size());
+    ParallelFor(out.size(), [&first, &second, out](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i) {
+            const std::int64_t difference{ Date::DaysFromCivil(second.years_[i], second.months_[i], second.days_[i]) -
+                                           Date::DaysFromCivil(first.years_[i], first.months_[i], first.days_[i]) };
+            out[i] = difference < 0 ? -difference : difference;
+        }
+    });
+}
+
+void DayOfYear(std::span<const Date> dates, std::span<unsigned> out) {
+    CheckSizes(dates.size(), out.size());
+    ParallelFor(out.size(), [dates, out](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            out[i] = Date::DayOfYear(dates[i]);
+    });
+}
+
+void DayOfYear(const DateColumn& dates, std::span<unsigned> out) {
+    CheckSizes(dates.Size(), out.size());
+    ParallelFor(out.size(), [&dates, out](std::size_t begin, std::size_t end) {
+        for(std::size_t i{ begin }; i < end; ++i)
+            out[i] = Date::DayOfYear(dates.years_[i], dates.months_[i], dates.days_[i]);
+    });
+}
+
+}  // namespace setm
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstddef>      // std::size_t.
+#include <cstdint>      // std::int64_t, std::uint8_t.
+#include <filesystem>   // std::filesystem::path.
+#include <span>         // std::span.
+#include <string_view>  // std::string_view.
+#include <vector>       // std::vector.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+/**
+ * @brief Stores a column of dates as a structure of arrays.
+ *
+ * Years, months, and days are kept in separate contiguous arrays (6 bytes per date),
+ * so the batch kernels below can process them with straight-line, vectorizable loops.
+ */
+class DateColumn {
+public:
+    // ========= Constructors: ========= //
+    DateColumn() = default;
+
+    /**
+     * @brief Constructs a column from an array of dates.
+     *
+     * @param dates The dates to store.
+     */
+    explicit DateColumn(std::span<const Date> dates);
+
+
+    // ========= Methods: ========= //
+    /**
+     * @brief Appends a date to the end of the column.
+     *
+     * @param date The date to append.
+     */
+    void PushBack(const Date& date);
+
+    /**
+     * @brief Reserves storage for the specified number of dates.
+     *
+     * @param capacity The number of dates to reserve storage for.
+     */
+    void Reserve(std::size_t capacity);
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] std::size_t Size() const noexcept;
+    [[nodiscard]] std::span<const int> Years() const noexcept;
+    [[nodiscard]] std::span<const std::uint8_t> Months() const noexcept;
+    [[nodiscard]] std::span<const std::uint8_t> Days() const noexcept;
+
+    /**
+     * @brief Retrieves the date at the specified position.
+     *
+     * @param index The position of the date (must be less than Size()).
+     * @return The date.
+     */
+    [[nodiscard]] Date operator[](std::size_t index) const;
+
+
+    // ========= Static functions: ========= //
+    /**
+     * @brief Parses a column of newline-separated dates.
+     *
+     * Every non-empty line must hold exactly one date in a format accepted by Date::FromChars
+     * ("\r\n" line endings are accepted). Large inputs are parsed in parallel.
+     *
+     * @param text The text to parse.
+     * @return The parsed column (in input order).
+     * @throws std::invalid_argument if a line is not a valid date (the message holds its byte offset).
+     */
+    [[nodiscard]] static DateColumn Parse(std::string_view text);
+
+    /**
+     * @brief Reads a file of newline-separated dates (see Parse()).
+     *
+     * @param path The path to the file.
+     * @return The parsed column.
+     * @throws std::runtime_error if the file cannot be read.
+     * @throws std::invalid_argument if a line is not a valid date.
+     */
+    [[nodiscard]] static DateColumn ReadFile(const std::filesystem::path& path);
+
+
+    // ========= Batch kernels: ========= //
+    friend void AddDays(DateColumn& dates, std::span<const int> numDays);
+    friend void AddMonths(DateColumn& dates, std::span<const int> numMonths);
+    friend void AddYears(DateColumn& dates, std::span<const int> numYears);
+    friend void Difference(const DateColumn& first, const DateColumn& second, std::span<std::int64_t> out);
+    friend void DayOfYear(const DateColumn& dates, std::span<unsigned> out);
+
+
+private:
+    std::vector<int> years_;
+    std::vector<std::uint8_t> months_;
+    std::vector<std::uint8_t> days_;
+};
+
+
+// ========= Batch kernels: ========= //
+// Large inputs are split across hardware threads.
+// All kernels throw std::invalid_argument if the sizes of the arguments do not match.
+
+/**
+ * @brief Adds a (possibly negative) number of days to every date.
+ *
+ * @param dates The dates to modify.
+ * @param numDays The number of days to add to the date at the same position.
+ */
+void AddDays(std::span<Date> dates, std::span<const int> numDays);
+void AddDays(DateColumn& dates, std::span<const int> numDays);
+
+/**
+ * @brief Adds a (possibly negative) number of months to every date, as in Date::AddMonths.
+ *
+ * @param dates The dates to modify.
+ * @param numMonths The number of months to add to the date at the same position.
+ */
+void AddMonths(std::span<Date> dates, std::span<const int> numMonths);
+void AddMonths(DateColumn& dates, std::span<const int> numMonths);
+
+/**
+ * @brief Adds a (possibly negative) number of years to every date, as in Date::AddYears.
+ *
+ * @param dates The dates to modify.
+ * @param numYears The number of years to add to the date at the same position.
+ */
+void AddYears(std::span<Date> dates, std::span<const int> numYears);
+void AddYears(DateColumn& dates, std::span<const int> numYears);
+
+/**
+ * @brief Calculates the difference in days between dates at the same positions.
+ *
+ * @param first The first dates.
+ * @param second The second dates.
+ * @param out Receives the differences (always positive, as in Date::Difference).
+ */
+void Difference(std::span<const Date> first, std::span<const Date> second, std::span<std::int64_t> out);
+void Difference(const DateColumn& first, const DateColumn& second, std::span<std::int64_t> out);
+
+/**
+ * @brief Calculates the day of the year for every date.
+ *
+ * @param dates The dates.
+ * @param out Receives the days of the year (1-366).
+ */
+void DayOfYear(std::span<const Date> dates, std::span<unsigned> out);
+void DayOfYear(const DateColumn& dates, std::span<unsigned> out);
+
+}  // namespace setm
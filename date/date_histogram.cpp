@@ -0,0 +1,205 @@
+#include "date_histogram.hpp"
+
+#include <algorithm>      // std::max, std::min, std::sort.
+#include <cstddef>        // std::size_t.
+#include <cstdint>        // std::int64_t, std::uint64_t, std::uint8_t.
+#include <limits>         // std::numeric_limits.
+#include <mutex>          // std::mutex, std::lock_guard.
+#include <span>           // std::span.
+#include <stdexcept>      // std::invalid_argument.
+#include <unordered_map>  // std::unordered_map.
+#include <vector>         // std::vector.
+
+#include "date.hpp"         // setm::Date.
+#include "date_column.hpp"  // setm::DateColumn.
+#include "parallel.hpp"     // setm::detail::ParallelChunk, setm::detail::ParallelFor.
+
+namespace setm {
+
+namespace {
+
+using detail::ParallelChunk;
+using detail::ParallelFor;
+
+// Dense tables are used when the range of bucket ids is at most this many times the number of dates...
+constexpr std::uint64_t DENSE_FACTOR{ 4 };
+
+// ... and at most this large.
+constexpr std::uint64_t DENSE_LIMIT{ 1 << 20 };
+
+// Floor division by a positive divisor, without branches.
+constexpr std::int64_t FloorDivide(std::int64_t value, std::int64_t divisor) noexcept {
+    return (value - (value < 0) * (divisor - 1)) / divisor;
+}
+
+// Bucket id of a date; the period is fixed at compile time so the loops below inline it.
+template<Period P>
+struct Bucketer {
+    std::int64_t operator()(int year, unsigned month, unsigned day) const noexcept {
+        if constexpr(P == Period::Day)
+            return Date::DaysFromCivil(year, month, day);
+        else if constexpr(P == Period::Week)
+            return FloorDivide(Date::DaysFromCivil(year, month, day) + 3, 7);  // 1969/12/29 is a Monday.
+        else if constexpr(P == Period::Month)
+            return static_cast<std::int64_t>(year) * 12 + month - 1;
+        else
+            return year;
+    }
+};
+
+// Calls body with the Bucketer for the period.
+template<typename F>
+decltype(auto) WithPeriod(Period period, F body) {
+    switch(period) {
+        case Period::Day: return body(Bucketer<Period::Day>{});
+        case Period::Week: return body(Bucketer<Period::Week>{});
+        case Period::Month: return body(Bucketer<Period::Month>{});
+        case Period::Year: break;
+    }
+    return body(Bucketer<Period::Year>{});
+}
+
+void Accumulate(BucketStats& stats, const double* value) noexcept {
+    if(value != nullptr) {
+        stats.sum += *value;
+        stats.min = stats.count == 0 ? *value : std::min(stats.min, *value);
+        stats.max = stats.count == 0 ? *value : std::max(stats.max, *value);
+    }
+    ++stats.count;
+}
+
+void Merge(BucketStats& into, const BucketStats& from) noexcept {
+    if(from.count == 0)
+        return;
+    into.min = into.count == 0 ? from.min : std::min(into.min, from.min);
+    into.max = into.count == 0 ? from.max : std::max(into.max, from.max);
+    into.sum += from.sum;
+    into.count += from.count;
+}
+
+// Aggregates the dates (and values, if not empty) per bucket.
+template<typename Bucket>
+std::vector<BucketStats> Aggregate(const DateColumn& dates, std::span<const double> values, Bucket bucketOf) {
+    const std::span<const int> years{ dates.Years() };
+    const std::span<const std::uint8_t> months{ dates.Months() };
+    const std::span<const std::uint8_t> days{ dates.Days() };
+    const std::size_t size{ dates.Size() };
+    if(size == 0)
+        return {};
+
+    // Find the range of bucket ids to choose between dense and hashed tables.
+    std::mutex mutex;
+    std::int64_t low{ std::numeric_limits<std::int64_t>::max() };
+    std::int64_t high{ std::numeric_limits<std::int64_t>::min() };
+    ParallelFor(size, [&](std::size_t begin, std::size_t end) {
+        std::int64_t localLow{ std::numeric_limits<std::int64_t>::max() };
+        std::int64_t localHigh{ std::numeric_limits<std::int64_t>::min() };
+        for(std::size_t i{ begin }; i < end; ++i) {
+            const std::int64_t bucket{ bucketOf(years[i], months[i], days[i]) };
+            localLow = std::min(localLow, bucket);
+            localHigh = std::max(localHigh, bucket);
+        }
+        const std::lock_guard lock{ mutex };
+        low = std::min(low, localLow);
+        high = std::max(high, localHigh);
+    });
+
+    std::vector<BucketStats> result;
+    const auto value{ [&values](std::size_t i) { return values.empty() ? nullptr : &values[i]; } };
+    const std::uint64_t range{ static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low) };
+    const std::size_t chunk{ ParallelChunk(size) };
+    if(range < std::min<std::uint64_t>(DENSE_LIMIT, chunk * DENSE_FACTOR)) {
+        // One table per chunk, filled without locks and then folded slice by slice.
+        std::vector<std::vector<BucketStats>> partials((size + chunk - 1) / chunk);
+        ParallelFor(size, [&](std::size_t begin, std::size_t end) {
+            std::vector<BucketStats>& partial{ partials[begin / chunk] };
+            partial.resize(static_cast<std::size_t>(range + 1));
+            for(std::size_t i{ begin }; i < end; ++i)
+                Accumulate(partial[static_cast<std::size_t>(bucketOf(years[i], months[i], days[i]) - low)], value(i));
+        });
+
+        std::vector<BucketStats>& table{ partials.front() };
+        ParallelFor(table.size(), [&](std::size_t begin, std::size_t end) {
+            for(std::size_t part{ 1 }; part < partials.size(); ++part)
+                for(std::size_t bucket{ begin }; bucket < end; ++bucket)
+                    Merge(table[bucket], partials[part][bucket]);
+        });
+
+        for(std::size_t bucket{}; bucket < table.size(); ++bucket) {
+            if(table[bucket].count > 0) {
+                table[bucket].bucket = low + static_cast<std::int64_t>(bucket);
+                result.push_back(table[bucket]);
+            }
+        }
+        return result;
+    }
+
+    // Sparse ids: hash the buckets instead.
+    std::unordered_map<std::int64_t, BucketStats> table;
+    ParallelFor(size, [&](std::size_t begin, std::size_t end) {
+        std::unordered_map<std::int64_t, BucketStats> partial;
+        for(std::size_t i{ begin }; i < end; ++i)
+            Accumulate(partial[bucketOf(years[i], months[i], days[i])], value(i));
+
+        const std::lock_guard lock{ mutex };
+        for(const auto& [bucket, stats] : partial)
+            Merge(table[bucket], stats);
+    });
+
+    result.reserve(table.size());
+    for(auto& [bucket, stats] : table) {
+        stats.bucket = bucket;
+        result.push_back(stats);
+    }
+    std::sort(result.begin(), result.end(), [](const BucketStats& a, const BucketStats& b) { return a.bucket < b.bucket; });
+    return result;
+}
+
+}  // Anonymous namespace.
+
+[[nodiscard]] std::int64_t BucketOf(const Date& date, Period period) noexcept {
+    return WithPeriod(period, [&date](auto bucketOf) { return bucketOf(date.Year(), date.Month(), date.Day()); });
+}
+
+[[nodiscard]] Date BucketStart(std::int64_t bucket, Period period) noexcept {
+    switch(period) {
+        case Period::Day: return Date::CivilFromDays(bucket);
+        case Period::Week: return Date::CivilFromDays(bucket * 7 - 3);
+        case Period::Month: {
+            const std::int64_t year{ FloorDivide(bucket, 12) };
+            return Date::CivilFromDays(Date::DaysFromCivil(static_cast<int>(year), static_cast<unsigned>(bucket - year * 12 + 1), 1));
+        }
+        case Period::Year: break;
+    }
+    return Date::CivilFromDays(Date::DaysFromCivil(static_cast<int>(bucket), 1, 1));
+}
+
+void BucketOf(const DateColumn& dates, Period period, std::span<std::int64_t> out) {
+    if(dates.Size() != out.size())
+        throw std::invalid_argument("Batch arguments have different sizes.");
+
+    const std::span<const int> years{ dates.Years() };
+    const std::span<const std::uint8_t> months{ dates.Months() };
+    const std::span<const std::uint8_t> days{ dates.Days() };
+    WithPeriod(period, [&](auto bucketOf) {
+        ParallelFor(out.size(), [&](std::size_t begin, std::size_t end) {
+            for(std::size_t i{ begin }; i < end; ++i)
+                out[i] = bucketOf(years[i], months[i], days[i]);
+        });
+    });
+}
+
+[[nodiscard]] std::vector<BucketStats> Histogram(const DateColumn& dates, Period period) {
+    return WithPeriod(period, [&](auto bucketOf) { return Aggregate(dates, {}, bucketOf); });
+}
+
+[[nodiscard]] std::vector<BucketStats> Histogram(const DateColumn& dates, std::span<const double> values, Period period) {
+    if(dates.Size() != values.size())
+        throw std::invalid_argument("Batch arguments have different sizes.");
+    if(values.empty())
+        return {};
+
+    return WithPeriod(period, [&](auto bucketOf) { return Aggregate(dates, values, bucketOf); });
+}
+
+}  // namespace setm
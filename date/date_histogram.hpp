@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>  // std::size_t.
+#include <cstdint>  // std::int64_t.
+#include <span>     // std::span.
+#include <vector>   // std::vector.
+
+#include "date.hpp"         // setm::Date.
+#include "date_column.hpp"  // setm::DateColumn.
+
+namespace setm {
+
+/**
+ * @brief Length of the buckets of a date histogram.
+ */
+enum class Period { Day, Week, Month, Year };
+
+/**
+ * @brief Aggregated values of the dates that fall into one bucket.
+ */
+struct BucketStats {
+    std::int64_t bucket{};  // Bucket id (see BucketOf).
+    std::size_t count{};    // Number of dates in the bucket.
+    double sum{};           // Sum of the values (0 when aggregating counts only).
+    double min{};           // Smallest value (0 when aggregating counts only).
+    double max{};           // Largest value (0 when aggregating counts only).
+};
+
+/**
+ * @brief Maps a date to the id of its bucket.
+ *
+ * Ids are consecutive integers: the serial day number for Period::Day, the number of ISO weeks
+ * (starting on Monday) since the week of 1970/1/1 for Period::Week, year * 12 + month - 1 for
+ * Period::Month, and the year for Period::Year.
+ *
+ * @param date The date.
+ * @param period The length of the buckets.
+ * @return The bucket id.
+ */
+[[nodiscard]] std::int64_t BucketOf(const Date& date, Period period) noexcept;
+
+/**
+ * @brief Retrieves the first date of a bucket.
+ *
+ * @param bucket The bucket id (see BucketOf).
+ * @param period The length of the buckets.
+ * @return The first date of the bucket.
+ */
+[[nodiscard]] Date BucketStart(std::int64_t bucket, Period period) noexcept;
+
+/**
+ * @brief Maps every date of a column to the id of its bucket.
+ *
+ * @param dates The dates.
+ * @param period The length of the buckets.
+ * @param out Receives the bucket ids.
+ * @throws std::invalid_argument if the sizes of dates and out do not match.
+ */
+void BucketOf(const DateColumn& dates, Period period, std::span<std::int64_t> out);
+
+/**
+ * @brief Counts the dates of a column per bucket.
+ *
+ * Large columns are split across hardware threads; every thread fills its own table,
+ * and the tables are merged at the end.
+ *
+ * @param dates The dates.
+ * @param period The length of the buckets.
+ * @return The non-empty buckets, ordered by id.
+ */
+[[nodiscard]] std::vector<BucketStats> Histogram(const DateColumn& dates, Period period);
+
+/**
+ * @brief Aggregates values per bucket of their dates (count, sum, min and max).
+ *
+ * @param dates The dates.
+ * @param values The value at the same position as each date.
+ * @param period The length of the buckets.
+ * @return The non-empty buckets, ordered by id.
+ * @throws std::invalid_argument if the sizes of dates and values do not match.
+ */
+[[nodiscard]] std::vector<BucketStats> Histogram(const DateColumn& dates, std::span<const double> values, Period period);
+
+}  // namespace setm
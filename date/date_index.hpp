@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>  // std::lower_bound, std::stable_sort.
+#include <cstddef>    // std::ptrdiff_t, std::size_t.
+#include <cstdint>    // std::int64_t.
+#include <span>       // std::span.
+#include <stdexcept>  // std::invalid_argument.
+#include <utility>    // std::move, std::pair.
+#include <vector>     // std::vector.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+/**
+ * @brief Read-optimized index of values keyed by date.
+ *
+ * Keys are stored as serial day numbers in one sorted array, next to a parallel array of values.
+ * A per-year table gives the slice of keys that belong to each year, and the lookup interpolates
+ * inside that slice (at most 366 distinct keys), so a point lookup usually touches one or two
+ * cache lines instead of the log2(n) lines of a binary search over Date objects.
+ * Keys spread over many more years than there are keys skip the table and use a binary search.
+ * Several values may share the same date; they keep their input order.
+ */
+template<typename V>
+class DateIndex {
+public:
+    // ========= Constructors: ========= //
+    DateIndex() = default;
+
+    /**
+     * @brief Builds the index from (date, value) pairs in any order.
+     *
+     * @param entries The entries to index.
+     */
+    explicit DateIndex(std::vector<std::pair<Date, V>> entries);
+
+    /**
+     * @brief Builds the index from parallel arrays of dates and values in any order.
+     *
+     * @param dates The keys.
+     * @param values The values.
+     * @throws std::invalid_argument if the spans have different sizes.
+     */
+    DateIndex(std::span<const Date> dates, std::span<const V> values);
+
+
+    // ========= Methods: ========= //
+    /**
+     * @brief Finds the first value stored for a date.
+     *
+     * @param date The key to look up.
+     * @return Pointer to the value, or nullptr if the date is not in the index.
+     */
+    [[nodiscard]] const V* Find(const Date& date) const noexcept;
+
+    /**
+     * @brief Returns all values stored for a date.
+     *
+     * @param date The key to look up.
+     * @return The values (empty if the date is not in the index).
+     */
+    [[nodiscard]] std::span<const V> EqualRange(const Date& date) const noexcept;
+
+    /**
+     * @brief Returns the values whose dates lie in [from, to).
+     *
+     * @param from The first date.
+     * @param to The date after the last one.
+     * @return The values, ordered by date (empty if to is not after from).
+     */
+    [[nodiscard]] std::span<const V> Range(const Date& from, const Date& to) const noexcept;
+
+    /**
+     * @brief Position of the first key that is not before a serial day number.
+     *
+     * @param days The serial day number (see Date::ToDays).
+     * @return The position in [0, Size()].
+     */
+    [[nodiscard]] std::size_t LowerBound(std::int64_t days) const noexcept;
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] std::size_t Size() const noexcept { return keys_.size(); }
+    [[nodiscard]] bool Empty() const noexcept { return keys_.empty(); }
+    [[nodiscard]] std::span<const std::int64_t> Keys() const noexcept { return keys_; }
+    [[nodiscard]] std::span<const V> Values() const noexcept { return values_; }
+
+
+private:
+    // Interpolation steps tried before falling back to binary search.
+    static constexpr int INTERPOLATION_STEPS{ 3 };
+
+    // Slices shorter than this are searched linearly.
+    static constexpr std::size_t LINEAR_THRESHOLD{ 8 };
+
+    // The year table is built only if the keys span at most this many years per key.
+    static constexpr std::int64_t YEARS_PER_KEY{ 4 };
+
+    void BuildYearTable();
+
+    std::vector<std::int64_t> keys_;        // Sorted serial day numbers.
+    std::vector<V> values_;                 // values_[i] belongs to keys_[i].
+    int firstYear_{};                       // Year of the first key.
+    std::vector<std::size_t> yearOffsets_;  // Position of the first key of every year, plus Size() (empty if too sparse).
+};
+
+
+template<typename V>
+DateIndex<V>::DateIndex(std::vector<std::pair<Date, V>> entries) {
+    std::vector<std::pair<std::int64_t, std::size_t>> order;
+    order.reserve(entries.size());
+    for(std::size_t i{}; i < entries.size(); ++i)
+        order.emplace_back(entries[i].first.ToDays(), i);
+    std::stable_sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+    keys_.reserve(order.size());
+    values_.reserve(order.size());
+    for(const auto& [days, position] : order) {
+        keys_.push_back(days);
+        values_.push_back(std::move(entries[position].second));
+    }
+    BuildYearTable();
+}
+
+template<typename V>
+DateIndex<V>::DateIndex(std::span<const Date> dates, std::span<const V> values)
+    : DateIndex{ [&] {
+          if(dates.size() != values.size())
+              throw std::invalid_argument("Dates and values must have the same size.");
+          std::vector<std::pair<Date, V>> entries;
+          entries.reserve(dates.size());
+          for(std::size_t i{}; i < dates.size(); ++i)
+              entries.emplace_back(dates[i], values[i]);
+          return entries;
+      }() } {}
+
+template<typename V>
+[[nodiscard]] const V* DateIndex<V>::Find(const Date& date) const noexcept {
+    const std::int64_t days{ date.ToDays() };
+    const std::size_t position{ LowerBound(days) };
+    return position < keys_.size() && keys_[position] == days ? &values_[position] : nullptr;
+}
+
+template<typename V>
+[[nodiscard]] std::span<const V> DateIndex<V>::EqualRange(const Date& date) const noexcept {
+    return Range(date, Date::CivilFromDays(date.ToDays() + 1));
+}
+
+template<typename V>
+[[nodiscard]] std::span<const V> DateIndex<V>::Range(const Date& from, const Date& to) const noexcept {
+    const std::size_t first{ LowerBound(from.ToDays()) };
+    const std::size_t last{ LowerBound(to.ToDays()) };
+    if(last <= first)
+        return {};
+    return std::span<const V>{ values_ }.subspan(first, last - first);
+}
+
+template<typename V>
+[[nodiscard]] std::size_t DateIndex<V>::LowerBound(std::int64_t days) const noexcept {
+    if(keys_.empty() || days <= keys_.front())
+        return 0;
+    if(days > keys_.back())
+        return keys_.size();
+    if(yearOffsets_.empty())
+        return static_cast<std::size_t>(std::lower_bound(keys_.begin(), keys_.end(), days) - keys_.begin());
+
+    // Narrow the search to the keys of the same year.
+    const std::size_t year{ static_cast<std::size_t>(Date::CivilFromDays(days).Year() - firstYear_) };
+    std::size_t low{ yearOffsets_[year] };
+    std::size_t high{ yearOffsets_[year + 1] };
+
+    // Interpolate: the answer is in [low, high], and keys_[high] (if any) is not before days.
+    for(int step{}; step < INTERPOLATION_STEPS && high - low > LINEAR_THRESHOLD; ++step) {
+        if(keys_[low] >= days)
+            return low;
+        const std::int64_t span{ keys_[high - 1] - keys_[low] };
+        if(span <= 0 || keys_[high - 1] < days)
+            break;
+        const std::size_t guess{ low + static_cast<std::size_t>((days - keys_[low]) * static_cast<std::int64_t>(high - 1 - low) / span) };
+        if(keys_[guess] < days)
+            low = guess + 1;
+        else
+            high = guess;
+    }
+
+    if(high - low <= LINEAR_THRESHOLD) {
+        while(low < high && keys_[low] < days)
+            ++low;
+        return low;
+    }
+    return static_cast<std::size_t>(std::lower_bound(keys_.begin() + static_cast<std::ptrdiff_t>(low),
+                                                     keys_.begin() + static_cast<std::ptrdiff_t>(high), days) -
+                                    keys_.begin());
+}
+
+template<typename V>
+void DateIndex<V>::BuildYearTable() {
+    yearOffsets_.clear();
+    if(keys_.empty())
+        return;
+
+    firstYear_ = Date::CivilFromDays(keys_.front()).Year();
+    const int lastYear{ Date::CivilFromDays(keys_.back()).Year() };
+    const std::int64_t years{ static_cast<std::int64_t>(lastYear) - firstYear_ + 1 };
+    if(years > static_cast<std::int64_t>(keys_.size()) * YEARS_PER_KEY)
+        return;
+    yearOffsets_.reserve(static_cast<std::size_t>(years) + 1);
+
+    std::size_t position{};
+    for(std::int64_t year{ firstYear_ }; year <= lastYear; ++year) {
+        const std::int64_t firstDay{ Date::DaysFromCivil(static_cast<int>(year), 1, 1) };
+        while(position < keys_.size() && keys_[position] < firstDay)
+            ++position;
+        yearOffsets_.push_back(position);
+    }
+    yearOffsets_.push_back(keys_.size());
+}
+
+}  // namespace setm
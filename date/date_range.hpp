@@ -0,0 +1,217 @@
+#pragma once
+
+#include <algorithm>  // std::min.
+#include <cstddef>    // std::ptrdiff_t.
+#include <cstdint>    // std::int64_t.
+#include <iterator>   // std::input_iterator_tag, std::random_access_iterator_tag.
+#include <ranges>     // std::ranges::view_interface.
+#include <stdexcept>  // std::invalid_argument.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+/**
+ * @brief Random-access iterator over a lazily computed sequence of dates.
+ *
+ * The iterator holds a single integer position; Mapping converts a position to a Date
+ * in constant time, so advancing by any distance is O(1).
+ */
+template<typename Mapping>
+class CalendarIterator {
+public:
+    // Dereferencing yields a prvalue, so only the C++20 concept is random access; like
+    // std::ranges::iota_view, the legacy category stays at input iterator.
+    using iterator_concept = std::random_access_iterator_tag;
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Date;
+    using difference_type = std::ptrdiff_t;
+    using reference = Date;
+
+    // ========= Constructors: ========= //
+    constexpr CalendarIterator() = default;
+    constexpr CalendarIterator(std::int64_t position, Mapping mapping) noexcept
+        : position_{ position }, mapping_{ mapping } {}
+
+
+    // ========= Access: ========= //
+    constexpr Date operator*() const noexcept { return mapping_(position_); }
+    constexpr Date operator[](difference_type offset) const noexcept { return mapping_(position_ + offset); }
+
+
+    // ========= Arithmetic: ========= //
+    constexpr CalendarIterator& operator++() noexcept { return *this += 1; }
+    constexpr CalendarIterator& operator--() noexcept { return *this -= 1; }
+    constexpr CalendarIterator operator++(int) noexcept {
+        CalendarIterator copy{ *this };
+        ++*this;
+        return copy;
+    }
+    constexpr CalendarIterator operator--(int) noexcept {
+        CalendarIterator copy{ *this };
+        --*this;
+        return copy;
+    }
+    constexpr CalendarIterator& operator+=(difference_type offset) noexcept {
+        position_ += offset;
+        return *this;
+    }
+    constexpr CalendarIterator& operator-=(difference_type offset) noexcept {
+        position_ -= offset;
+        return *this;
+    }
+    friend constexpr CalendarIterator operator+(CalendarIterator it, difference_type offset) noexcept { return it += offset; }
+    friend constexpr CalendarIterator operator+(difference_type offset, CalendarIterator it) noexcept { return it += offset; }
+    friend constexpr CalendarIterator operator-(CalendarIterator it, difference_type offset) noexcept { return it -= offset; }
+    friend constexpr difference_type operator-(const CalendarIterator& lhs, const CalendarIterator& rhs) noexcept {
+        return static_cast<difference_type>(lhs.position_ - rhs.position_);
+    }
+
+
+    // ========= Comparison operators: ========= //
+    friend constexpr bool operator==(const CalendarIterator& lhs, const CalendarIterator& rhs) noexcept {
+        return lhs.position_ == rhs.position_;
+    }
+    friend constexpr auto operator<=>(const CalendarIterator& lhs, const CalendarIterator& rhs) noexcept {
+        return lhs.position_ <=> rhs.position_;
+    }
+
+private:
+    std::int64_t position_{};
+    Mapping mapping_{};
+};
+
+/**
+ * @brief A lazy view over a sequence of dates; nothing is materialized.
+ */
+template<typename Mapping>
+class CalendarRange : public std::ranges::view_interface<CalendarRange<Mapping>> {
+public:
+    using iterator = CalendarIterator<Mapping>;
+
+    constexpr CalendarRange() = default;
+    constexpr CalendarRange(std::int64_t first, std::int64_t last, Mapping mapping) noexcept
+        : first_{ first }, last_{ std::max(first, last) }, mapping_{ mapping } {}
+
+    constexpr iterator begin() const noexcept { return { first_, mapping_ }; }
+    constexpr iterator end() const noexcept { return { last_, mapping_ }; }
+
+    /**
+     * @brief Takes every n-th date of the range.
+     *
+     * @param step The distance between the selected dates.
+     * @return The view of every step-th date, starting from the first one.
+     * @throws std::invalid_argument if the step is zero.
+     */
+    constexpr CalendarRange Step(std::int64_t step) const
+        requires requires(const Mapping& mapping) { mapping.Stepped(std::int64_t{}, std::int64_t{}); }
+    {
+        if(step <= 0)
+            throw std::invalid_argument("Invalid step.");
+        return { 0, (last_ - first_ + step - 1) / step, mapping_.Stepped(first_, step) };
+    }
+
+private:
+    std::int64_t first_{};
+    std::int64_t last_{};
+    Mapping mapping_{};
+};
+
+
+// ========= Mappings from positions to dates: ========= //
+/**
+ * @brief Maps a position to the date origin + position * step (in days).
+ */
+struct DayMapping {
+    std::int64_t origin{};
+    std::int64_t step{ 1 };
+
+    constexpr Date operator()(std::int64_t position) const noexcept {
+        return Date::CivilFromDays(origin + position * step);
+    }
+    constexpr DayMapping Stepped(std::int64_t first, std::int64_t factor) const noexcept {
+        return { origin + first * step, step * factor };
+    }
+};
+
+/**
+ * @brief Maps a month index (year * 12 + month - 1) to a date in that month.
+ *
+ * The day of the month is clamped to the length of the month (Jan 31 -> Feb 28/29).
+ */
+struct MonthMapping {
+    unsigned day{ 1 };
+
+    constexpr Date operator()(std::int64_t position) const noexcept {
+        // Floor division keeps months of negative years in order.
+        const std::int64_t year{ (position >= 0 ? position : position - 11) / 12 };
+        const unsigned month{ static_cast<unsigned>(position - year * 12) + 1 };
+        const unsigned clamped{ std::min(day, Date::DaysInMonth(static_cast<int>(year), month)) };
+        return Date::CivilFromDays(Date::DaysFromCivil(static_cast<int>(year), month, clamped));
+    }
+};
+
+/**
+ * @brief Maps a weekday ordinal (number of Mondays to Fridays since 1970/1/5) to a date.
+ */
+struct WeekdayMapping {
+    constexpr Date operator()(std::int64_t position) const noexcept {
+        const std::int64_t weeks{ (position >= 0 ? position : position - 4) / 5 };
+        return Date::CivilFromDays(MONDAY + weeks * 7 + (position - weeks * 5));
+    }
+
+    // The weekday ordinal of the first weekday on or after the given day.
+    static constexpr std::int64_t Ordinal(std::int64_t days) noexcept {
+        const std::int64_t sinceMonday{ days - MONDAY };
+        const std::int64_t weeks{ (sinceMonday >= 0 ? sinceMonday : sinceMonday - 6) / 7 };
+        return weeks * 5 + std::min<std::int64_t>(sinceMonday - weeks * 7, 5);
+    }
+
+    static constexpr std::int64_t MONDAY{ 4 };  // 1970/1/5.
+};
+
+
+// ========= Range factories: ========= //
+/**
+ * @brief Every day in [from, to).
+ *
+ * @param from The first date.
+ * @param to The date after the last one.
+ * @return The lazy view of the days (empty if to <= from); call Step(n) for every n-th day.
+ */
+constexpr CalendarRange<DayMapping> Days(const Date& from, const Date& to) noexcept {
+    return { from.ToDays(), to.ToDays(), DayMapping{} };
+}
+
+/**
+ * @brief The same day of every month in [from, to).
+ *
+ * @param from The first date; its day is kept (clamped to the length of shorter months).
+ * @param to The bound; dates on or after it are excluded.
+ * @return The lazy view of the monthly dates.
+ */
+constexpr CalendarRange<MonthMapping> Months(const Date& from, const Date& to) noexcept {
+    const std::int64_t first{ static_cast<std::int64_t>(from.Year()) * 12 + from.Month() - 1 };
+    std::int64_t last{ static_cast<std::int64_t>(to.Year()) * 12 + to.Month() - 1 };
+    const MonthMapping mapping{ from.Day() };
+    // The month of to is included only if its (clamped) date is before to.
+    if(mapping(last) < to)
+        ++last;
+    return { first, last, mapping };
+}
+
+/**
+ * @brief Every weekday (Monday to Friday) in [from, to).
+ *
+ * @param from The first date.
+ * @param to The date after the last one.
+ * @return The lazy view of the weekdays.
+ */
+constexpr CalendarRange<WeekdayMapping> Weekdays(const Date& from, const Date& to) noexcept {
+    return { WeekdayMapping::Ordinal(from.ToDays()), WeekdayMapping::Ordinal(to.ToDays()), WeekdayMapping{} };
+}
+
+}  // namespace setm
+
+template<typename Mapping>
+inline constexpr bool std::ranges::enable_borrowed_range<setm::CalendarRange<Mapping>> = true;
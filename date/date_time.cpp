@@ -0,0 +1,461 @@
+#include "date_time.hpp"
+
+#include <algorithm>    // std::clamp, std::find, std::is_sorted, std::max, std::sort, std::upper_bound.
+#include <array>        // std::array.
+#include <cctype>       // std::isalpha, std::isdigit.
+#include <cstddef>      // std::ptrdiff_t, std::size_t.
+#include <cstdint>      // std::int32_t, std::int64_t, std::uint8_t.
+#include <filesystem>   // std::filesystem::path.
+#include <fstream>      // std::ifstream.
+#include <functional>   // std::less.
+#include <iomanip>      // std::setfill, std::setw.
+#include <iterator>     // std::istreambuf_iterator.
+#include <limits>       // std::numeric_limits.
+#include <map>          // std::map.
+#include <memory>       // std::unique_ptr, std::make_unique.
+#include <mutex>        // std::mutex, std::lock_guard.
+#include <optional>     // std::optional, std::nullopt.
+#include <ostream>      // std::ostream.
+#include <span>         // std::span.
+#include <stdexcept>    // std::invalid_argument, std::runtime_error.
+#include <string>       // std::string.
+#include <string_view>  // std::string_view.
+#include <utility>      // std::move, std::pair.
+#include <vector>       // std::vector.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+namespace {
+
+// Root of the system zoneinfo database.
+const std::filesystem::path ZONEINFO_ROOT{ "/usr/share/zoneinfo" };
+
+// Size of a TZif header: magic, version, reserved bytes and six counts.
+constexpr std::size_t TZIF_HEADER_SIZE{ 44 };
+
+constexpr std::int64_t SECONDS_PER_DAY{ 86400 };
+
+// Rules are evaluated for years within about a million years of 1970; later times use the last switch.
+constexpr std::int64_t MAX_RULE_DAYS{ 365LL * 1'000'000 };
+
+// Reads big-endian integers from the bytes of a TZif file, checking bounds.
+class TzifReader {
+public:
+    explicit TzifReader(std::span<const unsigned char> bytes)
+        : bytes_{ bytes } {}
+
+    [[nodiscard]] std::int64_t Read(std::size_t width) {
+        Require(width);
+        std::uint64_t value{};
+        for(std::size_t i{}; i < width; ++i)
+            value = value << 8 | bytes_[position_ + i];
+        position_ += width;
+
+        // Sign-extend 4-byte values.
+        if(width == 4)
+            return static_cast<std::int32_t>(static_cast<std::uint32_t>(value));
+        return static_cast<std::int64_t>(value);
+    }
+
+    void Skip(std::size_t count) {
+        Require(count);
+        position_ += count;
+    }
+
+    [[nodiscard]] std::size_t Position() const noexcept { return position_; }
+
+private:
+    void Require(std::size_t count) const {
+        if(bytes_.size() - position_ < count)
+            throw std::runtime_error("Truncated TZif file.");
+    }
+
+    std::span<const unsigned char> bytes_;
+    std::size_t position_{};
+};
+
+struct TzifCounts {
+    std::size_t isUtCount;
+    std::size_t isStdCount;
+    std::size_t leapCount;
+    std::size_t timeCount;
+    std::size_t typeCount;
+    std::size_t charCount;
+};
+
+// Parses a TZif header and returns its version character and counts.
+std::pair<unsigned char, TzifCounts> ReadHeader(TzifReader& reader, std::span<const unsigned char> bytes) {
+    const std::size_t start{ reader.Position() };
+    reader.Skip(TZIF_HEADER_SIZE);
+    if(bytes[start] != 'T' || bytes[start + 1] != 'Z' || bytes[start + 2] != 'i' || bytes[start + 3] != 'f')
+        throw std::runtime_error("Not a TZif file.");
+
+    TzifReader counts{ bytes.subspan(start + 20) };
+    TzifCounts result{};
+    result.isUtCount = static_cast<std::size_t>(counts.Read(4));
+    result.isStdCount = static_cast<std::size_t>(counts.Read(4));
+    result.leapCount = static_cast<std::size_t>(counts.Read(4));
+    result.timeCount = static_cast<std::size_t>(counts.Read(4));
+    result.typeCount = static_cast<std::size_t>(counts.Read(4));
+    result.charCount = static_cast<std::size_t>(counts.Read(4));
+    if(result.typeCount == 0)
+        throw std::runtime_error("TZif file has no local time types.");
+    return { bytes[start + 4], result };
+}
+
+// Reads the parts of a POSIX TZ string, for example "CET-1CEST,M3.5.0,M10.5.0/3".
+class PosixReader {
+public:
+    explicit PosixReader(std::string_view text)
+        : text_{ text } {}
+
+    [[nodiscard]] bool AtEnd() const noexcept { return position_ == text_.size(); }
+    [[nodiscard]] char Peek() const noexcept { return AtEnd() ? '\0' : text_[position_]; }
+
+    bool Consume(char expected) noexcept {
+        if(Peek() != expected)
+            return false;
+        ++position_;
+        return true;
+    }
+
+    void Expect(char expected) {
+        if(!Consume(expected))
+            Fail();
+    }
+
+    // Skips a zone abbreviation: at least three letters, or at least three characters between '<' and '>'.
+    void SkipName() {
+        if(Consume('<')) {
+            const std::size_t close{ text_.find('>', position_) };
+            if(close == std::string_view::npos || close - position_ < 3)
+                Fail();
+            position_ = close + 1;
+            return;
+        }
+        const std::size_t start{ position_ };
+        while(std::isalpha(static_cast<unsigned char>(Peek())))
+            ++position_;
+        if(position_ - start < 3)
+            Fail();
+    }
+
+    // Reads "[+|-]hh[:mm[:ss]]" as a number of seconds.
+    [[nodiscard]] std::int32_t Duration(unsigned maxHours) {
+        const bool negative{ Consume('-') };
+        if(!negative)
+            Consume('+');
+        std::int32_t seconds{ static_cast<std::int32_t>(Number(maxHours)) * 3600 };
+        if(Consume(':')) {
+            seconds += static_cast<std::int32_t>(Number(59)) * 60;
+            if(Consume(':'))
+                seconds += static_cast<std::int32_t>(Number(59));
+        }
+        return negative ? -seconds : seconds;
+    }
+
+    // Reads a decimal number not greater than max.
+    [[nodiscard]] unsigned Number(unsigned max) {
+        const std::size_t start{ position_ };
+        unsigned value{};
+        while(std::isdigit(static_cast<unsigned char>(Peek()))) {
+            value = value * 10 + static_cast<unsigned>(text_[position_++] - '0');
+            if(value > max)
+                Fail();
+        }
+        if(position_ == start)
+            Fail();
+        return value;
+    }
+
+    [[noreturn]] static void Fail() {
+        throw std::runtime_error("Invalid TZ string in TZif file.");
+    }
+
+private:
+    std::string_view text_;
+    std::size_t position_{};
+};
+
+// Rounds a number of seconds down to a day number.
+constexpr std::int64_t FloorDays(std::int64_t seconds) noexcept {
+    return seconds >= 0 ? seconds / SECONDS_PER_DAY : (seconds + 1) / SECONDS_PER_DAY - 1;
+}
+
+// Size of a data block whose transition times are timeSize bytes wide.
+std::size_t BlockSize(const TzifCounts& counts, std::size_t timeSize) {
+    return counts.timeCount * (timeSize + 1) + counts.typeCount * 6 + counts.charCount +
+           counts.leapCount * (timeSize + 4) + counts.isStdCount + counts.isUtCount;
+}
+
+}  // Anonymous namespace.
+
+std::ostream& operator<<(std::ostream& os, const DateTime& dateTime) {
+    const char fill{ os.fill('0') };
+    os << dateTime.GetDate() << ' ' << std::setw(2) << dateTime.Hour() << ':' << std::setw(2) << dateTime.Minute()
+       << ':' << std::setw(2) << dateTime.Second();
+    os.fill(fill);
+    return os;
+}
+
+[[nodiscard]] std::int32_t TimeZone::Offset(const DateTime& utc) const noexcept {
+    return PeriodAt(utc.ToSeconds()).offset;
+}
+
+[[nodiscard]] DateTime TimeZone::ToLocal(const DateTime& utc) const noexcept {
+    return utc.AddSeconds(Offset(utc));
+}
+
+[[nodiscard]] DateTime TimeZone::ToUtc(const DateTime& local) const noexcept {
+    // Offsets are below one day and transitions are further apart, so the answer lies
+    // in one of the periods around the one that contains the local time read as UTC.
+    const std::int64_t seconds{ local.ToSeconds() };
+    const Period guess{ PeriodAt(seconds) };
+    std::array<Period, 3> periods{};
+    std::size_t count{};
+    if(guess.begin != std::numeric_limits<std::int64_t>::min())
+        periods[count++] = PeriodAt(guess.begin - 1);
+    periods[count++] = guess;
+    if(guess.end != std::numeric_limits<std::int64_t>::max())
+        periods[count++] = PeriodAt(guess.end);
+
+    std::int32_t beforeGap{ guess.offset };
+    for(std::size_t i{}; i < count; ++i) {
+        const std::int64_t candidate{ seconds - periods[i].offset };
+        if(candidate < periods[i].begin)
+            continue;
+        if(candidate >= periods[i].end) {
+            beforeGap = periods[i].offset;
+            continue;
+        }
+        return DateTime::FromSeconds(candidate);
+    }
+
+    // The local time was skipped: use the offset from before the change.
+    return DateTime::FromSeconds(seconds - beforeGap);
+}
+
+void TimeZone::ToLocal(std::span<const DateTime> utc, std::span<DateTime> local) const {
+    if(utc.size() != local.size())
+        throw std::invalid_argument("Input and output must have the same size.");
+
+    // Consecutive inputs usually fall into the same period: check it before searching.
+    Period period{ 1, 0, 0 };
+    for(std::size_t i{}; i < utc.size(); ++i) {
+        const std::int64_t seconds{ utc[i].ToSeconds() };
+        if(seconds < period.begin || seconds >= period.end)
+            period = PeriodAt(seconds);
+        local[i] = DateTime::FromSeconds(seconds + period.offset);
+    }
+}
+
+void TimeZone::ToUtc(std::span<const DateTime> local, std::span<DateTime> utc) const {
+    if(local.size() != utc.size())
+        throw std::invalid_argument("Input and output must have the same size.");
+
+    for(std::size_t i{}; i < local.size(); ++i)
+        utc[i] = ToUtc(local[i]);
+}
+
+[[nodiscard]] const std::string& TimeZone::Name() const noexcept {
+    return name_;
+}
+
+const TimeZone& TimeZone::Locate(std::string_view name) {
+    const std::filesystem::path relative{ name };
+    if(name.empty() || relative.is_absolute())
+        throw std::invalid_argument("Invalid time zone name.");
+    for(const std::filesystem::path& part : relative) {
+        if(part == "..")
+            throw std::invalid_argument("Invalid time zone name.");
+    }
+
+    // Zones are never removed, so the references handed out stay valid.
+    static std::mutex mutex;
+    static std::map<std::string, std::unique_ptr<TimeZone>, std::less<>> cache;
+
+    const std::lock_guard lock{ mutex };
+    if(const auto found{ cache.find(name) }; found != cache.end())
+        return *found->second;
+
+    auto zone{ std::make_unique<TimeZone>(FromFile(ZONEINFO_ROOT / relative)) };
+    zone->name_ = name;
+    return *cache.emplace(std::string{ name }, std::move(zone)).first->second;
+}
+
+TimeZone TimeZone::FromFile(const std::filesystem::path& path) {
+    std::ifstream file{ path, std::ios::binary };
+    if(!file)
+        throw std::runtime_error("Cannot open time zone file: " + path.string());
+    const std::vector<unsigned char> bytes{ std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{} };
+
+    // Version 2+ files repeat the data with 64-bit transition times after the version 1 block.
+    TzifReader reader{ bytes };
+    auto [version, counts]{ ReadHeader(reader, bytes) };
+    std::size_t timeSize{ 4 };
+    if(version >= '2') {
+        reader.Skip(BlockSize(counts, 4));
+        counts = ReadHeader(reader, bytes).second;
+        timeSize = 8;
+    }
+    const std::size_t blockStart{ reader.Position() };
+
+    TimeZone zone;
+    zone.name_ = path.string();
+    zone.transitions_.reserve(counts.timeCount);
+    for(std::size_t i{}; i < counts.timeCount; ++i)
+        zone.transitions_.push_back(reader.Read(timeSize));
+
+    std::vector<std::size_t> typeIndices(counts.timeCount);
+    for(std::size_t& index : typeIndices) {
+        index = static_cast<std::size_t>(reader.Read(1));
+        if(index >= counts.typeCount)
+            throw std::runtime_error("Invalid local time type in TZif file.");
+    }
+
+    std::vector<std::int32_t> typeOffsets(counts.typeCount);
+    for(std::int32_t& offset : typeOffsets) {
+        offset = static_cast<std::int32_t>(reader.Read(4));
+        reader.Skip(2);  // isdst and abbreviation index.
+    }
+
+    // Type 0 applies before the first transition.
+    zone.offsets_.reserve(counts.timeCount + 1);
+    zone.offsets_.push_back(typeOffsets[0]);
+    for(const std::size_t index : typeIndices)
+        zone.offsets_.push_back(typeOffsets[index]);
+    if(!std::is_sorted(zone.transitions_.begin(), zone.transitions_.end()))
+        throw std::runtime_error("TZif transitions are not sorted.");
+
+    // Version 2+ files end with a POSIX TZ string between newlines for times after the last transition.
+    if(version >= '2') {
+        const std::size_t footer{ blockStart + BlockSize(counts, timeSize) };
+        if(footer >= bytes.size() || bytes[footer] != '\n')
+            throw std::runtime_error("Truncated TZif file.");
+        const auto end{ std::find(bytes.begin() + static_cast<std::ptrdiff_t>(footer) + 1, bytes.end(), '\n') };
+        if(end == bytes.end())
+            throw std::runtime_error("Truncated TZif file.");
+        zone.rule_ = ParseRule(std::string(bytes.begin() + static_cast<std::ptrdiff_t>(footer) + 1, end));
+    }
+
+    return zone;
+}
+
+[[nodiscard]] std::size_t TimeZone::Interval(std::int64_t utc) const noexcept {
+    return static_cast<std::size_t>(std::upper_bound(transitions_.begin(), transitions_.end(), utc) - transitions_.begin());
+}
+
+[[nodiscard]] TimeZone::Period TimeZone::PeriodAt(std::int64_t utc) const noexcept {
+    const std::size_t interval{ Interval(utc) };
+    if(rule_ && interval == transitions_.size())
+        return RulePeriodAt(utc);
+
+    return { interval > 0 ? transitions_[interval - 1] : std::numeric_limits<std::int64_t>::min(),
+             interval < transitions_.size() ? transitions_[interval] : std::numeric_limits<std::int64_t>::max(),
+             offsets_[interval] };
+}
+
+[[nodiscard]] TimeZone::Period TimeZone::RulePeriodAt(std::int64_t utc) const noexcept {
+    const Rule& rule{ *rule_ };
+    const std::int64_t lastTransition{ transitions_.empty() ? std::numeric_limits<std::int64_t>::min() : transitions_.back() };
+    if(rule.daylight == rule.standard)
+        return { lastTransition, std::numeric_limits<std::int64_t>::max(), rule.standard };
+
+    // The switches of the years around the UTC year bracket the time, whatever the local year is.
+    const int year{ Date::CivilFromDays(std::clamp(FloorDays(utc), -MAX_RULE_DAYS, MAX_RULE_DAYS)).Year() };
+    std::array<std::pair<std::int64_t, std::int32_t>, 6> switches{};  // UTC time and the offset after it.
+    for(int i{}; i < 3; ++i) {
+        switches[2 * i] = { SwitchTime(rule.start, year - 1 + i, rule.standard), rule.daylight };
+        switches[2 * i + 1] = { SwitchTime(rule.end, year - 1 + i, rule.daylight), rule.standard };
+    }
+    std::sort(switches.begin(), switches.end());
+
+    Period period{ std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(),
+                   switches.front().second == rule.daylight ? rule.standard : rule.daylight };
+    for(const auto& [time, offset] : switches) {
+        if(time > utc) {
+            period.end = time;
+            break;
+        }
+        period = { time, std::numeric_limits<std::int64_t>::max(), offset };
+    }
+    period.begin = std::max(period.begin, lastTransition);
+    return period;
+}
+
+[[nodiscard]] std::int64_t TimeZone::SwitchTime(const RuleDate& date, int year, std::int32_t offsetBefore) noexcept {
+    std::int64_t day{ Date::DaysFromCivil(year, 1, 1) };
+    if(date.kind == 'J') {
+        // Julian days never count February 29.
+        day += date.day - 1 + (date.day >= 60 && Date::IsLeapYear(year));
+    } else if(date.kind == 'D') {
+        day += date.day;
+    } else {
+        // Day of the week (0 = Sunday) in the given week of the month; week 5 is the last one.
+        const std::int64_t first{ Date::DaysFromCivil(year, date.month, 1) };
+        const unsigned weekday{ Date::DayOfWeek(Date::CivilFromDays(first)) % 7 };
+        unsigned dayOfMonth{ 1 + (date.day + 7 - weekday) % 7 + 7 * (date.week - 1) };
+        while(dayOfMonth > Date::DaysInMonth(year, date.month))
+            dayOfMonth -= 7;
+        day = first + dayOfMonth - 1;
+    }
+    return day * SECONDS_PER_DAY + date.time - offsetBefore;
+}
+
+std::optional<TimeZone::Rule> TimeZone::ParseRule(std::string_view tz) {
+    if(tz.empty())
+        return std::nullopt;
+
+    const auto parseDate{ [](PosixReader& reader) {
+        RuleDate date{ 'D', 0, 0, 0, 2 * 3600 };  // Switches happen at 02:00 unless stated otherwise.
+        if(reader.Consume('J')) {
+            date.kind = 'J';
+            date.day = reader.Number(365);
+            if(date.day == 0)
+                PosixReader::Fail();
+        } else if(reader.Consume('M')) {
+            date.kind = 'M';
+            date.month = reader.Number(12);
+            reader.Expect('.');
+            date.week = reader.Number(5);
+            reader.Expect('.');
+            date.day = reader.Number(6);
+            if(date.month == 0 || date.week == 0)
+                PosixReader::Fail();
+        } else {
+            date.day = reader.Number(365);
+        }
+        if(reader.Consume('/'))
+            date.time = reader.Duration(167);
+        return date;
+    } };
+
+    // POSIX offsets are positive west of Greenwich, the opposite of UTC offsets.
+    PosixReader reader{ tz };
+    Rule rule{};
+    reader.SkipName();
+    rule.standard = -reader.Duration(24);
+    rule.daylight = rule.standard;
+    if(reader.AtEnd())
+        return rule;
+
+    reader.SkipName();
+    rule.daylight = reader.AtEnd() || reader.Peek() == ',' ? rule.standard + 3600 : -reader.Duration(24);
+    if(reader.AtEnd()) {
+        // No switch dates: use the US rules, as the reference tz code does.
+        rule.start = { 'M', 0, 2, 3, 2 * 3600 };
+        rule.end = { 'M', 0, 1, 11, 2 * 3600 };
+        return rule;
+    }
+    reader.Expect(',');
+    rule.start = parseDate(reader);
+    reader.Expect(',');
+    rule.end = parseDate(reader);
+    if(!reader.AtEnd())
+        PosixReader::Fail();
+    return rule;
+}
+
+}  // namespace setm
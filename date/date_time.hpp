@@ -0,0 +1,274 @@
+#pragma once
+
+#include <compare>      // std::strong_ordering.
+#include <cstddef>      // std::size_t.
+#include <cstdint>      // std::int32_t, std::int64_t.
+#include <filesystem>   // std::filesystem::path.
+#include <optional>     // std::optional.
+#include <ostream>      // std::ostream.
+#include <span>         // std::span.
+#include <stdexcept>    // std::invalid_argument.
+#include <string>       // std::string.
+#include <string_view>  // std::string_view.
+#include <vector>       // std::vector.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+/**
+ * @brief Represents a point in time with second resolution.
+ *
+ * The DateTime class stores the number of seconds since 1970/1/1 00:00:00, so it
+ * shares its epoch with the serial day numbers of Date. It carries no time zone:
+ * the same type holds UTC and local times, and TimeZone converts between them.
+ */
+class DateTime {
+public:
+    // ========= Constructors: ========= //
+    constexpr DateTime() = default;
+
+    /**
+     * @brief Constructs a DateTime object from a date and a time of day.
+     *
+     * @param date The date.
+     * @param hour The hour (0-23).
+     * @param minute The minute (0-59).
+     * @param second The second (0-59).
+     * @throws std::invalid_argument if the time of day is out of valid range.
+     */
+    constexpr explicit DateTime(const Date& date, unsigned hour = 0, unsigned minute = 0, unsigned second = 0);
+
+
+    // ========= Methods: ========= //
+    /**
+     * @brief Returns the point in time a number of seconds later (or earlier if negative).
+     *
+     * @param numSeconds The number of seconds to add.
+     * @return The new DateTime object.
+     */
+    [[nodiscard]] constexpr DateTime AddSeconds(std::int64_t numSeconds) const noexcept;
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] constexpr Date GetDate() const noexcept;
+    [[nodiscard]] constexpr unsigned Hour() const noexcept;
+    [[nodiscard]] constexpr unsigned Minute() const noexcept;
+    [[nodiscard]] constexpr unsigned Second() const noexcept;
+
+    /**
+     * @brief Retrieves the number of seconds since 1970/1/1 00:00:00.
+     *
+     * @return The number of seconds (negative for earlier points in time).
+     */
+    [[nodiscard]] constexpr std::int64_t ToSeconds() const noexcept;
+
+
+    // ========= Comparison operators: ========= //
+    constexpr std::strong_ordering operator<=>(const DateTime& other) const noexcept = default;
+
+
+    // ========= Static functions: ========= //
+    /**
+     * @brief Constructs a DateTime object from a number of seconds since 1970/1/1 00:00:00.
+     *
+     * @param seconds The number of seconds.
+     * @return The corresponding DateTime object.
+     */
+    [[nodiscard]] static constexpr DateTime FromSeconds(std::int64_t seconds) noexcept;
+
+
+    // ========= I/O friend operators: ========= //
+    /**
+     * @brief Outputs the date and time to the stream in the format "Y/M/D HH:MM:SS".
+     *
+     * @param os The output stream.
+     * @param dateTime The DateTime object to output.
+     * @return The modified output stream.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const DateTime& dateTime);
+
+
+private:
+    static constexpr std::int64_t SECONDS_PER_DAY_{ 86400 };
+
+    // Seconds since midnight, in [0, SECONDS_PER_DAY_).
+    [[nodiscard]] constexpr std::int64_t SecondOfDay() const noexcept;
+
+    std::int64_t seconds_{};  // Number of seconds since 1970/1/1 00:00:00.
+};
+
+/**
+ * @brief A time zone loaded from a TZif file of the system zoneinfo database.
+ *
+ * The transitions of the zone are kept in two compact arrays (UTC transition times and
+ * UTC offsets). A TimeZone is immutable, so conversions are plain lookups that do not lock.
+ * Points in time after the last transition of the file follow the POSIX TZ rule stored at the
+ * end of version 2+ files (or keep the last offset if the file has no rule).
+ */
+class TimeZone {
+public:
+    // ========= Methods: ========= //
+    /**
+     * @brief Retrieves the UTC offset in effect at a point in time.
+     *
+     * @param utc The point in time (UTC).
+     * @return The offset in seconds (local time minus UTC).
+     */
+    [[nodiscard]] std::int32_t Offset(const DateTime& utc) const noexcept;
+
+    /**
+     * @brief Converts a UTC time to the local time of the zone.
+     *
+     * @param utc The UTC time.
+     * @return The local time.
+     */
+    [[nodiscard]] DateTime ToLocal(const DateTime& utc) const noexcept;
+
+    /**
+     * @brief Converts a local time of the zone to UTC.
+     *
+     * @param local The local time.
+     * @return The UTC time. An ambiguous local time (when clocks go back) maps to the earlier
+     *         instant; a local time skipped when clocks go forward uses the offset from before the change.
+     */
+    [[nodiscard]] DateTime ToUtc(const DateTime& local) const noexcept;
+
+    /**
+     * @brief Converts UTC times to local times in bulk.
+     *
+     * @param utc The UTC times.
+     * @param local The output local times.
+     * @throws std::invalid_argument if the spans have different sizes.
+     */
+    void ToLocal(std::span<const DateTime> utc, std::span<DateTime> local) const;
+
+    /**
+     * @brief Converts local times to UTC in bulk.
+     *
+     * @param local The local times.
+     * @param utc The output UTC times.
+     * @throws std::invalid_argument if the spans have different sizes.
+     */
+    void ToUtc(std::span<const DateTime> local, std::span<DateTime> utc) const;
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] const std::string& Name() const noexcept;
+
+
+    // ========= Static functions: ========= //
+    /**
+     * @brief Finds a zone of the system zoneinfo database by name (for example "Europe/Berlin").
+     *
+     * The file is parsed on the first request only; later requests return the cached zone.
+     *
+     * @param name The name of the zone.
+     * @return Reference to the zone, valid until the end of the program.
+     * @throws std::invalid_argument if the name is not a relative path inside the database.
+     * @throws std::runtime_error if the file cannot be read or is not a valid TZif file.
+     */
+    [[nodiscard]] static const TimeZone& Locate(std::string_view name);
+
+    /**
+     * @brief Loads a zone from a TZif file (without caching it).
+     *
+     * @param path The path of the file.
+     * @return The zone.
+     * @throws std::runtime_error if the file cannot be read or is not a valid TZif file.
+     */
+    [[nodiscard]] static TimeZone FromFile(const std::filesystem::path& path);
+
+
+private:
+    // Day of the year on which a rule switches, with the local time of the switch.
+    struct RuleDate {
+        char kind;          // 'J' (Julian day 1-365, no leap day), 'D' (zero-based day 0-365) or 'M' (month.week.day).
+        unsigned day;       // Day of the year for 'J' and 'D', day of the week (0 = Sunday) for 'M'.
+        unsigned week;      // Week of the month (1-5, 5 = last) for 'M'.
+        unsigned month;     // Month for 'M'.
+        std::int32_t time;  // Local time of the switch in seconds (may be negative or exceed one day).
+    };
+
+    // Yearly daylight saving rule of a POSIX TZ string.
+    struct Rule {
+        std::int32_t standard;  // UTC offset of standard time.
+        std::int32_t daylight;  // UTC offset of daylight saving time (equal to standard if there is none).
+        RuleDate start;         // Switch to daylight saving time (given in standard time).
+        RuleDate end;           // Switch back to standard time (given in daylight saving time).
+    };
+
+    // Interval [begin, end) of UTC times with the same offset.
+    struct Period {
+        std::int64_t begin;
+        std::int64_t end;
+        std::int32_t offset;
+    };
+
+    TimeZone() = default;
+
+    // Index of the offset in effect at a UTC time (number of transitions not after it).
+    [[nodiscard]] std::size_t Interval(std::int64_t utc) const noexcept;
+
+    // Period containing a UTC time, from the transitions or the rule after the last transition.
+    [[nodiscard]] Period PeriodAt(std::int64_t utc) const noexcept;
+
+    // Period containing a UTC time after the last transition, from the rule.
+    [[nodiscard]] Period RulePeriodAt(std::int64_t utc) const noexcept;
+
+    // UTC time at which a rule switches in a year, given the offset in effect before the switch.
+    [[nodiscard]] static std::int64_t SwitchTime(const RuleDate& date, int year, std::int32_t offsetBefore) noexcept;
+
+    // Parses the POSIX TZ string at the end of a TZif file (empty if the file has none).
+    [[nodiscard]] static std::optional<Rule> ParseRule(std::string_view tz);
+
+    std::string name_;                       // Name of the zone (or path of the file).
+    std::vector<std::int64_t> transitions_;  // UTC times at which offsets_[i + 1] takes effect.
+    std::vector<std::int32_t> offsets_;      // UTC offsets; offsets_[0] applies before the first transition.
+    std::optional<Rule> rule_;               // Rule for times after the last transition, if the file has one.
+};
+
+
+constexpr DateTime::DateTime(const Date& date, unsigned hour, unsigned minute, unsigned second) {
+    if(hour > 23 || minute > 59 || second > 59)
+        throw std::invalid_argument("Invalid time of day.");
+
+    seconds_ = date.ToDays() * SECONDS_PER_DAY_ + hour * 3600 + minute * 60 + second;
+}
+
+[[nodiscard]] constexpr DateTime DateTime::AddSeconds(std::int64_t numSeconds) const noexcept {
+    return FromSeconds(seconds_ + numSeconds);
+}
+
+[[nodiscard]] constexpr Date DateTime::GetDate() const noexcept {
+    return Date::CivilFromDays((seconds_ - SecondOfDay()) / SECONDS_PER_DAY_);
+}
+
+[[nodiscard]] constexpr unsigned DateTime::Hour() const noexcept {
+    return static_cast<unsigned>(SecondOfDay() / 3600);
+}
+
+[[nodiscard]] constexpr unsigned DateTime::Minute() const noexcept {
+    return static_cast<unsigned>(SecondOfDay() / 60 % 60);
+}
+
+[[nodiscard]] constexpr unsigned DateTime::Second() const noexcept {
+    return static_cast<unsigned>(SecondOfDay() % 60);
+}
+
+[[nodiscard]] constexpr std::int64_t DateTime::ToSeconds() const noexcept {
+    return seconds_;
+}
+
+[[nodiscard]] constexpr DateTime DateTime::FromSeconds(std::int64_t seconds) noexcept {
+    DateTime dateTime;
+    dateTime.seconds_ = seconds;
+    return dateTime;
+}
+
+[[nodiscard]] constexpr std::int64_t DateTime::SecondOfDay() const noexcept {
+    const std::int64_t remainder{ seconds_ % SECONDS_PER_DAY_ };
+    return remainder < 0 ? remainder + SECONDS_PER_DAY_ : remainder;
+}
+
+}  // namespace setm
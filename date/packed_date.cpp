@@ -0,0 +1,61 @@
+#include "packed_date.hpp"
+
+#include <cstdint>    // std::int32_t, std::int64_t.
+#include <limits>     // std::numeric_limits.
+#include <ostream>    // std::ostream.
+#include <stdexcept>  // std::out_of_range.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+PackedDate::PackedDate(int year, unsigned month, unsigned day)
+    : PackedDate{ Date{ year, month, day } } {}
+
+PackedDate::PackedDate(const Date& date) {
+    const std::int64_t days{ date.ToDays() };
+    if(days < std::numeric_limits<std::int32_t>::min() || days > std::numeric_limits<std::int32_t>::max())
+        throw std::out_of_range("Date is out of the packed range.");
+
+    days_ = static_cast<std::int32_t>(days);
+}
+
+void PackedDate::AddDays(unsigned numDays) {
+    const std::int64_t days{ static_cast<std::int64_t>(days_) + numDays };
+    if(days > std::numeric_limits<std::int32_t>::max())
+        throw std::out_of_range("Date is out of the packed range.");
+
+    days_ = static_cast<std::int32_t>(days);
+}
+
+[[nodiscard]] Date PackedDate::ToDate() const noexcept {
+    return Date::CivilFromDays(days_);
+}
+
+[[nodiscard]] int PackedDate::Year() const noexcept {
+    return ToDate().Year();
+}
+
+[[nodiscard]] unsigned PackedDate::Month() const noexcept {
+    return ToDate().Month();
+}
+
+[[nodiscard]] unsigned PackedDate::Day() const noexcept {
+    return ToDate().Day();
+}
+
+[[nodiscard]] std::int32_t PackedDate::ToDays() const noexcept {
+    return days_;
+}
+
+PackedDate PackedDate::FromDays(std::int32_t days) noexcept {
+    PackedDate date;
+    date.days_ = days;
+    return date;
+}
+
+std::ostream& operator<<(std::ostream& os, const PackedDate& date) {
+    return os << date.ToDate();
+}
+
+}  // namespace setm
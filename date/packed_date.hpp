@@ -0,0 +1,110 @@
+#pragma once
+
+#include <compare>  // std::strong_ordering.
+#include <cstdint>  // std::int32_t, std::int64_t.
+#include <ostream>  // std::ostream.
+
+#include "date.hpp"  // setm::Date.
+
+namespace setm {
+
+/**
+ * @brief Represents a date packed into 32 bits.
+ *
+ * The PackedDate class stores a date as its serial day number (days since 1970/1/1),
+ * so it takes 4 bytes instead of 12 and two dates are compared with a single integer
+ * comparison. Year, month, and day are decoded on demand.
+ */
+class PackedDate {
+public:
+    // ========= Constructors: ========= //
+    /**
+     * @brief Constructs a PackedDate object with the specified year, month, and day.
+     *
+     * @param year The year of the date.
+     * @param month The month of the date.
+     * @param day The day of the date.
+     * @throws std::invalid_argument if the month or day is out of valid range.
+     * @throws std::out_of_range if the date cannot be represented in 32 bits.
+     */
+    PackedDate(int year, unsigned month, unsigned day);
+
+    /**
+     * @brief Constructs a PackedDate object from a Date.
+     *
+     * @param date The date to pack.
+     * @throws std::out_of_range if the date cannot be represented in 32 bits.
+     */
+    explicit PackedDate(const Date& date);
+
+
+    // ========= Methods: ========= //
+    /**
+     * @brief Modifies the date by adding a specified number of days.
+     *
+     * @param numDays The number of days to add to the date.
+     * @throws std::out_of_range if the result cannot be represented in 32 bits (the date is then unchanged).
+     */
+    void AddDays(unsigned numDays);
+
+    /**
+     * @brief Unpacks the date.
+     *
+     * @return The equivalent Date object.
+     */
+    [[nodiscard]] Date ToDate() const noexcept;
+
+
+    // ========= Getters: ========= //
+    [[nodiscard]] int Year() const noexcept;
+    [[nodiscard]] unsigned Month() const noexcept;
+    [[nodiscard]] unsigned Day() const noexcept;
+
+    /**
+     * @brief Retrieves the serial day number of the date.
+     *
+     * @return The number of days since 1970/1/1 (negative for earlier dates).
+     */
+    [[nodiscard]] std::int32_t ToDays() const noexcept;
+
+
+    // ========= Comparison operators: ========= //
+    /**
+     * @brief Compares two PackedDate objects using the spaceship operator.
+     *
+     * @param other The PackedDate object to compare against.
+     * @return Strong ordering result (<, ==, or >), the same as for the equivalent Date objects.
+     */
+    std::strong_ordering operator<=>(const PackedDate& other) const noexcept = default;
+
+
+    // ========= Static functions: ========= //
+    /**
+     * @brief Constructs a PackedDate object from a serial day number.
+     *
+     * @param days The number of days since 1970/1/1.
+     * @return The corresponding PackedDate object.
+     */
+    [[nodiscard]] static PackedDate FromDays(std::int32_t days) noexcept;
+
+
+    // ========= I/O friend operators: ========= //
+    /**
+     * @brief Outputs the date to the stream in the same format as Date.
+     *
+     * @param os The output stream.
+     * @param date The PackedDate object to output.
+     * @return The modified output stream.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const PackedDate& date);
+
+
+private:
+    PackedDate() = default;
+
+    std::int32_t days_{};  // Number of days since 1970/1/1.
+};
+
+static_assert(sizeof(PackedDate) == 4);
+
+}  // namespace setm
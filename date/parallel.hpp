@@ -0,0 +1,38 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min.
+#include <cstddef>    // std::size_t.
+#include <thread>     // std::thread.
+#include <vector>     // std::vector.
+
+namespace setm::detail {
+
+// Inputs shorter than this (per thread) are processed on the calling thread.
+inline constexpr std::size_t PARALLEL_THRESHOLD{ 1 << 16 };
+
+// Length of the chunks ParallelFor splits [0, size) into; size itself when it runs on the calling thread.
+inline std::size_t ParallelChunk(std::size_t size) noexcept {
+    const std::size_t maxThreads{ std::max(1u, std::thread::hardware_concurrency()) };
+    const std::size_t threads{ std::min(maxThreads, size / PARALLEL_THRESHOLD) };
+    return threads <= 1 ? size : (size + threads - 1) / threads;
+}
+
+// Calls body(begin, end) on consecutive chunks of [0, size), in parallel for large sizes.
+template<typename F>
+void ParallelFor(std::size_t size, F body) {
+    const std::size_t chunk{ ParallelChunk(size) };
+    if(chunk >= size) {
+        body(std::size_t{}, size);
+        return;
+    }
+
+    std::vector<std::thread> pool;
+    for(std::size_t begin{ chunk }; begin < size; begin += chunk)
+        pool.emplace_back(body, begin, std::min(size, begin + chunk));
+    body(std::size_t{}, chunk);
+
+    for(std::thread& thread : pool)
+        thread.join();
+}
+
+}  // namespace setm::detail
@@ -1,11 +1,33 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <ranges>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <tuple>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "business_calendar.hpp"
 #include "date.hpp"
+#include "date_codec.hpp"
+#include "date_column.hpp"
+#include "date_histogram.hpp"
+#include "date_index.hpp"
+#include "date_range.hpp"
+#include "date_time.hpp"
+#include "packed_date.hpp"
 
 namespace setm {
 
@@ -133,6 +155,712 @@ TEST(DateClass, AddDays) {
     EXPECT_EQ(date, Date(29383, 3, 26));
 }
 
+TEST(DateClass, AddDaysMatchesDayByDay) {
+    // Adding days in one step must match stepping one day at a time.
+    Date stepped{ -401, 2, 27 };
+    for(unsigned offset{ 1 }; offset <= 1'000'000; ++offset) {
+        const int year{ stepped.Year() };
+        const unsigned month{ stepped.Month() };
+        const unsigned day{ stepped.Day() };
+        stepped = day < Date::DaysInMonth(year, month) ? Date{ year, month, day + 1 }
+                  : month < 12                         ? Date{ year, month + 1, 1 }
+                                                       : Date{ year + 1, 1, 1 };
+        if(offset % 997 == 0) {
+            Date added{ -401, 2, 27 };
+            added.AddDays(offset);
+            ASSERT_EQ(added, stepped) << "offset " << offset;
+        }
+    }
+}
+
+TEST(DateClass, SerialDays) {
+    EXPECT_EQ(Date::DaysFromCivil(1970, 1, 1), 0);
+    EXPECT_EQ(Date::DaysFromCivil(2000, 3, 1), 11017);
+    EXPECT_EQ(Date::DaysFromCivil(1969, 12, 31), -1);
+    EXPECT_EQ(Date::CivilFromDays(0), Date(1970, 1, 1));
+    EXPECT_EQ(Date::CivilFromDays(-719468), Date(0, 3, 1));
+
+    for(std::int64_t days{ -1'000'000 }; days <= 1'000'000; days += 7) {
+        ASSERT_EQ(Date::CivilFromDays(days).ToDays(), days);
+    }
+}
+
+TEST(PackedDateClass, MatchesDate) {
+    const PackedDate packed{ 2004, 2, 29 };
+    EXPECT_EQ(packed.Year(), 2004);
+    EXPECT_EQ(packed.Month(), 2);
+    EXPECT_EQ(packed.Day(), 29);
+    EXPECT_EQ(packed.ToDate(), Date(2004, 2, 29));
+    EXPECT_EQ(PackedDate::FromDays(0), PackedDate(1970, 1, 1));
+
+    EXPECT_THROW(PackedDate(2001, 2, 29), std::invalid_argument);
+    EXPECT_THROW(PackedDate(Date{ 7'000'000, 1, 1 }), std::out_of_range);
+
+    // Ordering must be the same as for Date.
+    const Date dates[]{ { -101, 1, 2 }, { -100, 1, 1 }, { 0, 12, 31 }, { 2003, 5, 17 }, { 2003, 5, 20 }, { 2004, 2, 29 } };
+    for(const Date& lhs : dates) {
+        for(const Date& rhs : dates) {
+            EXPECT_EQ(PackedDate{ lhs } <=> PackedDate{ rhs }, lhs <=> rhs);
+        }
+    }
+
+    PackedDate added{ 2002, 5, 14 };
+    Date expected{ 2002, 5, 14 };
+    added.AddDays(10'000'000);
+    expected.AddDays(10'000'000);
+    EXPECT_EQ(added.ToDate(), expected);
+
+    // Results beyond 32 bits are rejected and leave the date unchanged.
+    PackedDate last{ PackedDate::FromDays(std::numeric_limits<std::int32_t>::max() - 1) };
+    EXPECT_NO_THROW(last.AddDays(1));
+    EXPECT_THROW(last.AddDays(1), std::out_of_range);
+    EXPECT_THROW(added.AddDays(std::numeric_limits<unsigned>::max()), std::out_of_range);
+    EXPECT_EQ(last, PackedDate::FromDays(std::numeric_limits<std::int32_t>::max()));
+
+    std::stringstream ss;
+    ss << packed;
+    EXPECT_EQ(ss.str(), "2004/2/29");
+}
+
+TEST(DateBatch, MatchesScalar) {
+    // Large enough to be split across threads.
+    std::vector<Date> dates;
+    std::vector<Date> others;
+    std::vector<int> offsets;
+    for(int i{}; i < 300'000; ++i) {
+        dates.push_back(Date::CivilFromDays(i * 37 - 5'000'000));
+        others.push_back(Date::CivilFromDays(i * 11 - 1'000'000));
+        offsets.push_back(i % 2 == 0 ? i * 13 : -i * 7);
+    }
+    DateColumn column{ dates };
+    const DateColumn otherColumn{ others };
+
+    std::vector<std::int64_t> differences(dates.size());
+    std::vector<std::int64_t> columnDifferences(dates.size());
+    Difference(dates, others, differences);
+    Difference(column, otherColumn, columnDifferences);
+
+    std::vector<unsigned> daysOfYear(dates.size());
+    std::vector<unsigned> columnDaysOfYear(dates.size());
+    DayOfYear(dates, daysOfYear);
+    DayOfYear(column, columnDaysOfYear);
+
+    for(std::size_t i{}; i < dates.size(); ++i) {
+        ASSERT_EQ(differences[i], Date::Difference(dates[i], others[i]));
+        ASSERT_EQ(columnDifferences[i], differences[i]);
+        ASSERT_EQ(daysOfYear[i], Date::DayOfYear(dates[i]));
+        ASSERT_EQ(columnDaysOfYear[i], daysOfYear[i]);
+    }
+
+    std::vector<Date> added{ dates };
+    AddDays(added, offsets);
+    AddDays(column, offsets);
+    for(std::size_t i{}; i < dates.size(); ++i) {
+        ASSERT_EQ(added[i], Date::CivilFromDays(dates[i].ToDays() + offsets[i]));
+        ASSERT_EQ(column[i], added[i]);
+    }
+
+    EXPECT_THROW(AddDays(column, std::span<const int>{ offsets }.first(3)), std::invalid_argument);
+}
+
+TEST(DateClass, FromChars) {
+    for(const std::string_view text : { "2004-02-29", "2004/02/29", "20040229" }) {
+        Date date{ 2000, 1, 1 };
+        const std::from_chars_result result{ Date::FromChars(text.data(), text.data() + text.size(), date) };
+        EXPECT_EQ(result.ec, std::errc{}) << text;
+        EXPECT_EQ(result.ptr, text.data() + text.size()) << text;
+        EXPECT_EQ(date, Date(2004, 2, 29)) << text;
+    }
+
+    for(const std::string_view text : { "2001-02-29", "2004-13-01", "2004-02/01", "2004-2-1", "2004020", "20x40229", "",
+                                        "-101-01-02", "+12345-01", "+12345-01/01", "+99999999999-01-01", "-0001-02-29", "+" }) {
+        Date date{ 2000, 1, 1 };
+        const std::from_chars_result result{ Date::FromChars(text.data(), text.data() + text.size(), date) };
+        EXPECT_EQ(result.ec, std::errc::invalid_argument) << text;
+        EXPECT_EQ(date, Date(2000, 1, 1)) << text;
+    }
+}
+
+TEST(DateClass, ToChars) {
+    char buffer[16];
+    const auto format{ [&buffer](const Date& date) {
+        const std::to_chars_result result{ date.ToChars(buffer, buffer + sizeof(buffer)) };
+        EXPECT_EQ(result.ec, std::errc{});
+        return std::string(buffer, result.ptr);
+    } };
+
+    EXPECT_EQ(format(Date{ 2002, 5, 14 }), "2002-05-14");
+    EXPECT_EQ(format(Date{ 150, 3, 25 }), "0150-03-25");
+    EXPECT_EQ(format(Date{ -101, 1, 2 }), "-0101-01-02");
+    EXPECT_EQ(format(Date{ 29383, 3, 26 }), "+29383-03-26");
+    EXPECT_EQ(format(Date{ -12345, 12, 31 }), "-12345-12-31");
+
+    // Every year round-trips through FromChars, including expanded ones.
+    for(const Date date : { Date{ -101, 1, 2 }, Date{ 29383, 3, 26 }, Date{ -1, 2, 28 }, Date{ 10000, 2, 29 }, Date{ 0, 1, 1 } }) {
+        const std::string text{ format(date) };
+        Date parsed{ 2000, 1, 1 };
+        const std::from_chars_result result{ Date::FromChars(text.data(), text.data() + text.size(), parsed) };
+        EXPECT_EQ(result.ec, std::errc{}) << text;
+        EXPECT_EQ(result.ptr, text.data() + text.size()) << text;
+        EXPECT_EQ(parsed, date) << text;
+    }
+    EXPECT_EQ(Date(-101, 1, 2).ToChars(buffer, buffer + 10).ec, std::errc::value_too_large);
+
+    EXPECT_EQ(Date(2002, 5, 14).ToChars(buffer, buffer + 9).ec, std::errc::value_too_large);
+}
+
+TEST(DateColumnClass, Parse) {
+    const DateColumn column{ DateColumn::Parse("2004-02-29\r\n2004/03/01\n\n19991231\n") };
+    ASSERT_EQ(column.Size(), 3);
+    EXPECT_EQ(column[0], Date(2004, 2, 29));
+    EXPECT_EQ(column[1], Date(2004, 3, 1));
+    EXPECT_EQ(column[2], Date(1999, 12, 31));
+
+    EXPECT_THROW(static_cast<void>(DateColumn::Parse("2004-02-29\n2004-02-30\n")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(DateColumn::Parse("2004-02-29 \n")), std::invalid_argument);
+
+    // Large enough to be parsed in parallel.
+    std::string text;
+    std::vector<Date> expected;
+    char buffer[16];
+    for(int i{}; i < 200'000; ++i) {
+        expected.push_back(Date::CivilFromDays(i * 3));
+        text.append(buffer, expected.back().ToChars(buffer, buffer + sizeof(buffer)).ptr);
+        text += '\n';
+    }
+    const std::filesystem::path path{ std::filesystem::temp_directory_path() / "setm_date_column.txt" };
+    std::ofstream{ path } << text;
+    const DateColumn large{ DateColumn::ReadFile(path) };
+    std::filesystem::remove(path);
+
+    ASSERT_EQ(large.Size(), expected.size());
+    for(std::size_t i{}; i < expected.size(); ++i)
+        ASSERT_EQ(large[i], expected[i]);
+
+    EXPECT_THROW(static_cast<void>(DateColumn::ReadFile(path)), std::runtime_error);
+}
+
+TEST(DateClass, Constexpr) {
+    // Calendar computations on literal dates fold into compile-time constants.
+    static_assert(Date::IsLeapYear(2000) && !Date::IsLeapYear(1900));
+    static_assert(Date::DaysInMonth(2004, 2) == 29);
+    static_assert(Date::DayOfYear(Date{ 2004, 3, 1 }) == 61);
+    static_assert(Date::DayOfYear(Date{ 2003, 12, 31 }) == 365);
+    static_assert(Date::DayOfYear(-4, 12, 31) == 366);
+    static_assert([] {
+        int year{ -1 };
+        unsigned month{ 3 };
+        unsigned day{ 31 };
+        Date::ShiftMonths(year, month, day, -13);
+        return Date{ year, month, day };
+    }() == Date{ -2, 2, 28 });
+    static_assert(Date{ 1970, 1, 1 }.ToDays() == 0);
+    static_assert(Date::Difference(Date{ 2003, 5, 17 }, Date{ 2004, 2, 29 }) == 288);
+    static_assert([] {
+        Date date{ 2004, 2, 29 };
+        date.AddDays(10'000'000);
+        return date;
+    }() == Date{ 29383, 3, 26 });
+}
+
+TEST(DateClass, DayOfWeek) {
+    EXPECT_EQ(Date::DayOfWeek(Date{ 1970, 1, 1 }), 4);   // Thursday.
+    EXPECT_EQ(Date::DayOfWeek(Date{ 2023, 12, 31 }), 7);  // Sunday.
+    EXPECT_EQ(Date::DayOfWeek(Date{ 2024, 1, 1 }), 1);    // Monday.
+    EXPECT_EQ(Date::DayOfWeek(Date{ 1969, 12, 29 }), 1);  // Monday.
+    EXPECT_EQ(Date::DayOfWeek(Date{ -1, 1, 1 }), 5);      // Friday.
+}
+
+TEST(DateRange, Days) {
+    static_assert(std::ranges::random_access_range<decltype(Days(Date{ 2004, 1, 1 }, Date{ 2004, 1, 1 }))>);
+    static_assert(std::ranges::sized_range<decltype(Days(Date{ 2004, 1, 1 }, Date{ 2004, 1, 1 }))>);
+    static_assert(std::same_as<std::iterator_traits<std::ranges::iterator_t<decltype(Days(Date{ 2004, 1, 1 }, Date{ 2004, 1, 1 }))>>::iterator_category,
+                               std::input_iterator_tag>);  // Dereferencing yields a prvalue.
+
+    // Every day of the first quarter of a leap year.
+    const auto quarter{ Days(Date{ 2004, 1, 1 }, Date{ 2004, 4, 1 }) };
+    EXPECT_EQ(quarter.size(), 91);
+    EXPECT_EQ(quarter.front(), Date(2004, 1, 1));
+    EXPECT_EQ(quarter.back(), Date(2004, 3, 31));
+    EXPECT_EQ(quarter[59], Date(2004, 2, 29));
+
+    Date expected{ 2004, 1, 1 };
+    for(const Date& date : quarter) {
+        EXPECT_EQ(date, expected);
+        expected.AddDays(1);
+    }
+
+    const auto weekly{ quarter.Step(7) };
+    EXPECT_EQ(weekly.size(), 13);
+    EXPECT_EQ(weekly[1], Date(2004, 1, 8));
+    EXPECT_EQ(weekly.back(), Date(2004, 3, 25));
+    EXPECT_THROW(static_cast<void>(quarter.Step(0)), std::invalid_argument);
+
+    EXPECT_TRUE(Days(Date{ 2004, 4, 1 }, Date{ 2004, 1, 1 }).empty());
+}
+
+TEST(DateRange, Months) {
+    const auto months{ Months(Date{ 2003, 10, 31 }, Date{ 2004, 3, 31 }) };
+    const std::vector<Date> expected{ { 2003, 10, 31 }, { 2003, 11, 30 }, { 2003, 12, 31 }, { 2004, 1, 31 }, { 2004, 2, 29 } };
+    ASSERT_EQ(months.size(), expected.size());
+    EXPECT_TRUE(std::ranges::equal(months, expected));
+
+    // Month ends over 50 years.
+    EXPECT_EQ(Months(Date{ 1970, 1, 31 }, Date{ 2020, 1, 1 }).size(), 600);
+    EXPECT_EQ(Months(Date{ -1, 11, 15 }, Date{ 0, 3, 1 }).size(), 4);
+    EXPECT_EQ(Months(Date{ -1, 11, 15 }, Date{ 0, 3, 1 })[2], Date(0, 1, 15));
+}
+
+TEST(DateRange, Weekdays) {
+    // 2024/1/1 is a Monday.
+    const auto weekdays{ Weekdays(Date{ 2023, 12, 30 }, Date{ 2024, 1, 15 }) };
+    EXPECT_EQ(weekdays.size(), 10);
+    EXPECT_EQ(weekdays.front(), Date(2024, 1, 1));
+    EXPECT_EQ(weekdays[5], Date(2024, 1, 8));
+    EXPECT_EQ(weekdays.back(), Date(2024, 1, 12));
+
+    const auto days{ Days(Date{ 1969, 6, 1 }, Date{ 1970, 6, 1 }) };
+    const auto isWeekday{ [](const Date& date) { return Date::DayOfWeek(date) <= 5; } };
+    const auto range{ Weekdays(Date{ 1969, 6, 1 }, Date{ 1970, 6, 1 }) };
+    EXPECT_EQ(static_cast<std::ptrdiff_t>(range.size()), std::ranges::count_if(days, isWeekday));
+    EXPECT_TRUE(std::ranges::all_of(range, isWeekday));
+}
+
+TEST(BusinessCalendarClass, Queries) {
+    // 2024/1/1 is a Monday; 2024/1/1 and 2024/12/25 are holidays.
+    const std::vector<Date> holidays{ { 2024, 1, 1 }, { 2024, 12, 25 }, { 1999, 1, 1 } };
+    const BusinessCalendar calendar{ Date{ 2000, 1, 1 }, Date{ 2099, 12, 31 }, holidays };
+
+    EXPECT_FALSE(calendar.IsBusinessDay(Date{ 2024, 1, 1 }));
+    EXPECT_TRUE(calendar.IsBusinessDay(Date{ 2024, 1, 2 }));
+    EXPECT_FALSE(calendar.IsBusinessDay(Date{ 2024, 1, 6 }));  // Saturday.
+    EXPECT_THROW(static_cast<void>(calendar.IsBusinessDay(Date{ 1999, 12, 31 })), std::out_of_range);
+
+    EXPECT_EQ(calendar.AddBusinessDays(Date{ 2023, 12, 29 }, 1), Date(2024, 1, 2));  // Friday -> Tuesday.
+    EXPECT_EQ(calendar.AddBusinessDays(Date{ 2024, 1, 6 }, 1), Date(2024, 1, 8));    // Saturday -> Monday.
+    EXPECT_EQ(calendar.AddBusinessDays(Date{ 2024, 1, 2 }, -1), Date(2023, 12, 29));
+    EXPECT_EQ(calendar.AddBusinessDays(Date{ 2024, 1, 7 }, -1), Date(2024, 1, 5));
+    EXPECT_EQ(calendar.AddBusinessDays(Date{ 2024, 1, 6 }, 0), Date(2024, 1, 6));
+    EXPECT_THROW(static_cast<void>(calendar.AddBusinessDays(Date{ 2099, 12, 30 }, 10)), std::out_of_range);
+
+    EXPECT_EQ(calendar.BusinessDaysBetween(Date{ 2024, 1, 1 }, Date{ 2024, 1, 8 }), 4);
+    EXPECT_EQ(calendar.BusinessDaysBetween(Date{ 2024, 1, 8 }, Date{ 2024, 1, 1 }), -4);
+    EXPECT_EQ(calendar.BusinessDaysBetween(Date{ 2000, 1, 1 }, Date{ 2100, 1, 1 }),
+              std::ranges::count_if(Days(Date{ 2000, 1, 1 }, Date{ 2100, 1, 1 }), [&calendar](const Date& date) { return calendar.IsBusinessDay(date); }));
+
+    // Stepping one business day at a time must match a single jump.
+    Date stepped{ 2023, 12, 20 };
+    for(int i{ 1 }; i <= 300; ++i) {
+        stepped = calendar.AddBusinessDays(stepped, 1);
+        ASSERT_EQ(calendar.AddBusinessDays(Date{ 2023, 12, 20 }, i), stepped);
+        ASSERT_EQ(calendar.AddBusinessDays(stepped, -i), Date(2023, 12, 20));
+    }
+}
+
+TEST(BusinessCalendarClass, FromFile) {
+    const std::filesystem::path path{ std::filesystem::temp_directory_path() / "setm_holidays.txt" };
+    std::ofstream{ path } << "2024-01-01\n2024-12-25\n";
+    const BusinessCalendar calendar{ BusinessCalendar::FromFile(path, Date{ 2024, 1, 1 }, Date{ 2024, 12, 31 }) };
+    std::filesystem::remove(path);
+
+    EXPECT_EQ(calendar.First(), Date(2024, 1, 1));
+    EXPECT_EQ(calendar.Last(), Date(2024, 12, 31));
+    EXPECT_FALSE(calendar.IsBusinessDay(Date{ 2024, 12, 25 }));
+    EXPECT_EQ(calendar.BusinessDaysBetween(Date{ 2024, 1, 1 }, Date{ 2025, 1, 1 }), 262 - 2);
+}
+
+TEST(DateIndexClass, MatchesLowerBound) {
+    // Unsorted keys with gaps and duplicates, spread over a few decades.
+    std::vector<std::pair<Date, int>> entries;
+    for(int i{}; i < 20000; ++i)
+        entries.emplace_back(Date::CivilFromDays(Date::DaysFromCivil(1990, 1, 1) + (i * 7919) % 12000 + (i % 3 == 0 ? 0 : i % 5)), i);
+    const DateIndex<int> index{ entries };
+
+    std::vector<std::int64_t> keys;
+    for(const auto& [date, value] : entries)
+        keys.push_back(date.ToDays());
+    std::ranges::sort(keys);
+    ASSERT_TRUE(std::ranges::equal(index.Keys(), keys));
+
+    for(std::int64_t days{ keys.front() - 10 }; days <= keys.back() + 10; ++days)
+        ASSERT_EQ(index.LowerBound(days), static_cast<std::size_t>(std::ranges::lower_bound(keys, days) - keys.begin()));
+
+    // Values with the same date keep their input order.
+    const Date date{ entries[3].first };
+    const std::span<const int> values{ index.EqualRange(date) };
+    ASSERT_FALSE(values.empty());
+    EXPECT_EQ(*index.Find(date), values.front());
+    EXPECT_TRUE(std::ranges::is_sorted(values));
+    for(const int value : values)
+        EXPECT_EQ(entries[static_cast<std::size_t>(value)].first, date);
+}
+
+TEST(DateIndexClass, Range) {
+    const std::vector<Date> dates{ { 2024, 3, 1 }, { 2023, 12, 31 }, { 2024, 1, 1 }, { 2024, 2, 29 } };
+    const std::vector<std::string> values{ "march", "eve", "new year", "leap" };
+    const DateIndex<std::string> index{ dates, values };
+
+    EXPECT_EQ(index.Size(), 4U);
+    EXPECT_TRUE(std::ranges::equal(index.Range(Date{ 2024, 1, 1 }, Date{ 2024, 3, 1 }), std::vector<std::string>{ "new year", "leap" }));
+    EXPECT_TRUE(index.Range(Date{ 2024, 3, 1 }, Date{ 2024, 1, 1 }).empty());
+    EXPECT_EQ(index.Range(Date{ 2000, 1, 1 }, Date{ 2100, 1, 1 }).size(), 4U);
+    EXPECT_EQ(index.Find(Date{ 2024, 2, 28 }), nullptr);
+    EXPECT_EQ(*index.Find(Date{ 2023, 12, 31 }), "eve");
+    EXPECT_TRUE(DateIndex<int>{}.Range(Date{ 2000, 1, 1 }, Date{ 2100, 1, 1 }).empty());
+
+    const std::vector<int> tooShort{ 1 };
+    EXPECT_THROW((DateIndex<int>{ dates, tooShort }), std::invalid_argument);
+}
+
+TEST(DateIndexClass, ExtremeYears) {
+    // Far apart keys skip the year table.
+    const std::vector<Date> sparse{ { 1, 1, 1 }, { 1000000, 1, 1 } };
+    const std::vector<int> values{ 1, 2 };
+    const DateIndex<int> index{ sparse, values };
+    EXPECT_EQ(*index.Find(Date{ 1000000, 1, 1 }), 2);
+    EXPECT_EQ(index.Find(Date{ 500000, 1, 1 }), nullptr);
+    EXPECT_EQ(index.LowerBound(Date{ 2, 1, 1 }.ToDays()), 1U);
+
+    // The last year of the table is the largest year a Date can hold.
+    constexpr int maxYear{ std::numeric_limits<int>::max() };
+    const std::vector<Date> last{ { maxYear, 6, 1 }, { maxYear - 1, 12, 31 }, { maxYear, 1, 1 } };
+    const std::vector<int> lastValues{ 1, 2, 3 };
+    const DateIndex<int> lastIndex{ last, lastValues };
+    EXPECT_EQ(*lastIndex.Find(Date{ maxYear, 6, 1 }), 1);
+    EXPECT_EQ(lastIndex.Range(Date{ maxYear, 1, 1 }, Date{ maxYear, 12, 31 }).size(), 2U);
+    EXPECT_EQ(lastIndex.LowerBound(Date{ maxYear, 3, 1 }.ToDays()), 2U);
+}
+
+TEST(DateTimeClass, Fields) {
+    constexpr DateTime dateTime{ Date{ 1969, 12, 31 }, 23, 59, 58 };
+    static_assert(dateTime.ToSeconds() == -2);
+    static_assert(dateTime.AddSeconds(2) == DateTime{});
+    static_assert(dateTime.GetDate() == Date{ 1969, 12, 31 } && dateTime.Hour() == 23 && dateTime.Second() == 58);
+
+    const DateTime leap{ Date{ 2024, 2, 29 }, 12, 30, 5 };
+    EXPECT_EQ(leap.AddSeconds(12 * 3600).GetDate(), Date(2024, 3, 1));
+    EXPECT_EQ(leap.Minute(), 30U);
+    EXPECT_THROW(DateTime(Date{ 2024, 2, 29 }, 24), std::invalid_argument);
+
+    std::ostringstream out;
+    out << leap;
+    EXPECT_EQ(out.str(), "2024/2/29 12:30:05");
+}
+
+TEST(TimeZoneClass, Conversions) {
+    if(!std::filesystem::exists("/usr/share/zoneinfo/Europe/Berlin"))
+        GTEST_SKIP() << "Zoneinfo database is not installed.";
+
+    const TimeZone& berlin{ TimeZone::Locate("Europe/Berlin") };
+    EXPECT_EQ(&berlin, &TimeZone::Locate("Europe/Berlin"));
+    EXPECT_EQ(berlin.Name(), "Europe/Berlin");
+
+    // Clocks go forward at 2024/3/31 01:00 UTC and back at 2024/10/27 01:00 UTC.
+    EXPECT_EQ(berlin.ToLocal(DateTime{ Date{ 2024, 3, 31 }, 0, 59, 59 }), DateTime(Date{ 2024, 3, 31 }, 1, 59, 59));
+    EXPECT_EQ(berlin.ToLocal(DateTime{ Date{ 2024, 3, 31 }, 1 }), DateTime(Date{ 2024, 3, 31 }, 3));
+    EXPECT_EQ(berlin.Offset(DateTime{ Date{ 2024, 7, 1 } }), 7200);
+    EXPECT_EQ(berlin.ToUtc(DateTime{ Date{ 2024, 3, 31 }, 2, 30 }), DateTime(Date{ 2024, 3, 31 }, 1, 30));    // Skipped.
+    EXPECT_EQ(berlin.ToUtc(DateTime{ Date{ 2024, 10, 27 }, 2, 30 }), DateTime(Date{ 2024, 10, 27 }, 0, 30));  // Ambiguous.
+    EXPECT_EQ(berlin.ToUtc(DateTime{ Date{ 2024, 1, 15 }, 9 }), DateTime(Date{ 2024, 1, 15 }, 8));
+
+    // Far beyond the stored transitions, the rule at the end of the file applies.
+    EXPECT_EQ(berlin.Offset(DateTime{ Date{ 2040, 7, 1 } }), 7200);
+    EXPECT_EQ(berlin.Offset(DateTime{ Date{ 2040, 12, 1 } }), 3600);
+    EXPECT_EQ(berlin.Offset(DateTime{ Date{ 2400, 8, 15 } }), 7200);
+
+    // Round trips and the batch API agree with the scalar conversions.
+    std::vector<DateTime> utc;
+    for(std::int64_t seconds{ DateTime{ Date{ 1900, 1, 1 } }.ToSeconds() }; seconds < DateTime{ Date{ 2100, 1, 1 } }.ToSeconds(); seconds += 86399)
+        utc.push_back(DateTime::FromSeconds(seconds));
+    std::vector<DateTime> local(utc.size());
+    std::vector<DateTime> back(utc.size());
+    berlin.ToLocal(utc, local);
+    berlin.ToUtc(local, back);
+    for(std::size_t i{}; i < utc.size(); ++i) {
+        ASSERT_EQ(local[i], berlin.ToLocal(utc[i]));
+        ASSERT_EQ(berlin.ToLocal(back[i]), local[i]);
+    }
+    EXPECT_THROW(berlin.ToLocal(utc, std::span<DateTime>{ local }.first(1)), std::invalid_argument);
+
+    EXPECT_THROW(static_cast<void>(TimeZone::Locate("../etc/passwd")), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(TimeZone::Locate("No/Such_Zone")), std::runtime_error);
+}
+
+namespace {
+
+// Writes a version 2 TZif file without transitions, as zic writes slim files for zones with a fixed rule.
+std::filesystem::path WriteSlimTzif(const std::string& name, std::int32_t offset, const std::string& tz) {
+    std::string bytes;
+    const auto put32{ [&bytes](std::uint32_t value) {
+        for(int shift{ 24 }; shift >= 0; shift -= 8)
+            bytes += static_cast<char>(value >> shift & 0xFF);
+    } };
+    for(int block{}; block < 2; ++block) {
+        bytes += "TZif2";
+        bytes.append(15, '\0');
+        for(const std::uint32_t count : { 0U, 0U, 0U, 0U, 1U, 4U })  // One local time type, four abbreviation bytes.
+            put32(count);
+        put32(static_cast<std::uint32_t>(offset));
+        bytes += '\0';  // isdst.
+        bytes += '\0';  // Abbreviation index.
+        bytes.append("ABC", 4);
+    }
+    bytes += '\n' + tz + '\n';
+
+    const std::filesystem::path path{ std::filesystem::temp_directory_path() / name };
+    std::ofstream{ path, std::ios::binary } << bytes;
+    return path;
+}
+
+}  // Anonymous namespace.
+
+TEST(TimeZoneClass, PosixRules) {
+    const std::filesystem::path path{ WriteSlimTzif("setm_tz_cet", 3600, "CET-1CEST,M3.5.0,M10.5.0/3") };
+    const TimeZone cet{ TimeZone::FromFile(path) };
+    std::filesystem::remove(path);
+
+    // Clocks go forward at 2040/3/25 01:00 UTC and back at 2040/10/28 01:00 UTC.
+    EXPECT_EQ(cet.Offset(DateTime{ Date{ 2040, 1, 1 } }), 3600);
+    EXPECT_EQ(cet.Offset(DateTime{ Date{ 2040, 7, 1 } }), 7200);
+    EXPECT_EQ(cet.ToLocal(DateTime{ Date{ 2040, 3, 25 }, 0, 59, 59 }), DateTime(Date{ 2040, 3, 25 }, 1, 59, 59));
+    EXPECT_EQ(cet.ToLocal(DateTime{ Date{ 2040, 3, 25 }, 1 }), DateTime(Date{ 2040, 3, 25 }, 3));
+    EXPECT_EQ(cet.ToLocal(DateTime{ Date{ 2040, 10, 28 }, 0, 59, 59 }), DateTime(Date{ 2040, 10, 28 }, 2, 59, 59));
+    EXPECT_EQ(cet.ToLocal(DateTime{ Date{ 2040, 10, 28 }, 1 }), DateTime(Date{ 2040, 10, 28 }, 2));
+    EXPECT_EQ(cet.ToUtc(DateTime{ Date{ 2040, 3, 25 }, 2, 30 }), DateTime(Date{ 2040, 3, 25 }, 1, 30));    // Skipped.
+    EXPECT_EQ(cet.ToUtc(DateTime{ Date{ 2040, 10, 28 }, 2, 30 }), DateTime(Date{ 2040, 10, 28 }, 0, 30));  // Ambiguous.
+
+    // The batch API agrees with the scalar conversions across many switches.
+    std::vector<DateTime> utc;
+    for(std::int64_t seconds{ DateTime{ Date{ 1960, 1, 1 } }.ToSeconds() }; seconds < DateTime{ Date{ 2200, 1, 1 } }.ToSeconds(); seconds += 86399)
+        utc.push_back(DateTime::FromSeconds(seconds));
+    std::vector<DateTime> local(utc.size());
+    std::vector<DateTime> back(utc.size());
+    cet.ToLocal(utc, local);
+    cet.ToUtc(local, back);
+    for(std::size_t i{}; i < utc.size(); ++i) {
+        ASSERT_EQ(local[i], cet.ToLocal(utc[i]));
+        ASSERT_EQ(cet.ToLocal(back[i]), local[i]);
+    }
+
+    // Southern hemisphere: daylight saving time spans the new year.
+    const std::filesystem::path sydneyPath{ WriteSlimTzif("setm_tz_aest", 36000, "AEST-10AEDT,M10.1.0,M4.1.0/3") };
+    const TimeZone sydney{ TimeZone::FromFile(sydneyPath) };
+    std::filesystem::remove(sydneyPath);
+    EXPECT_EQ(sydney.Offset(DateTime{ Date{ 2041, 1, 15 } }), 39600);
+    EXPECT_EQ(sydney.Offset(DateTime{ Date{ 2041, 7, 1 } }), 36000);
+
+    // Julian days skip February 29, zero-based days do not; numeric names and fixed offsets.
+    const std::filesystem::path julianPath{ WriteSlimTzif("setm_tz_julian", 0, "<+00>0<+01>,J60/0,300") };
+    const TimeZone julian{ TimeZone::FromFile(julianPath) };
+    std::filesystem::remove(julianPath);
+    EXPECT_EQ(julian.Offset(DateTime{ Date{ 2024, 2, 29 }, 23, 59, 59 }), 0);
+    EXPECT_EQ(julian.Offset(DateTime{ Date{ 2024, 3, 1 } }), 3600);
+    EXPECT_EQ(julian.Offset(DateTime{ Date{ 2024, 10, 27 }, 0, 59, 59 }), 3600);
+    EXPECT_EQ(julian.Offset(DateTime{ Date{ 2024, 10, 27 }, 1 }), 0);
+
+    const std::filesystem::path fixedPath{ WriteSlimTzif("setm_tz_fixed", -10800, "<-03>3") };
+    EXPECT_EQ(TimeZone::FromFile(fixedPath).Offset(DateTime{ Date{ 2100, 6, 1 } }), -10800);
+    std::filesystem::remove(fixedPath);
+
+    const std::filesystem::path invalidPath{ WriteSlimTzif("setm_tz_invalid", 3600, "CET-1CEST,M13.5.0,M10.5.0/3") };
+    EXPECT_THROW(static_cast<void>(TimeZone::FromFile(invalidPath)), std::runtime_error);
+    std::filesystem::remove(invalidPath);
+}
+
+TEST(DateClass, AddMonthsAndYears) {
+    constexpr Date clamped{ [] {
+        Date date{ 2024, 1, 31 };
+        date.AddMonths(1);
+        return date;
+    }() };
+    static_assert(clamped == Date{ 2024, 2, 29 });
+
+    Date date{ 2023, 1, 31 };
+    date.AddMonths(1);
+    EXPECT_EQ(date, Date(2023, 2, 28));
+    date.AddMonths(-14);
+    EXPECT_EQ(date, Date(2021, 12, 28));
+    date.AddMonths(-24 * 12 - 1);
+    EXPECT_EQ(date, Date(1997, 11, 28));
+
+    Date leap{ 2024, 2, 29 };
+    leap.AddYears(1);
+    EXPECT_EQ(leap, Date(2025, 2, 28));
+    leap = Date{ 2024, 2, 29 };
+    leap.AddYears(-4);
+    EXPECT_EQ(leap, Date(2020, 2, 29));
+
+    Date back{ 2024, 3, 1 };
+    back.SubtractDays(1);
+    EXPECT_EQ(back, Date(2024, 2, 29));
+    back.SubtractDays(-366);
+    EXPECT_EQ(back, Date(2025, 3, 1));
+
+    // Negative years are handled with floor division.
+    Date ancient{ 0, 1, 15 };
+    ancient.AddMonths(-1);
+    EXPECT_EQ(ancient, Date(-1, 12, 15));
+}
+
+TEST(DateBatch, AddMonthsAndYearsMatchScalar) {
+    std::vector<Date> dates;
+    std::vector<int> offsets;
+    for(int i{}; i < 200000; ++i) {
+        dates.push_back(Date::CivilFromDays(i * 37 - 3000000));
+        offsets.push_back(i % 401 - 200);
+    }
+
+    std::vector<Date> spanMonths{ dates };
+    AddMonths(spanMonths, offsets);
+    std::vector<Date> spanYears{ dates };
+    AddYears(spanYears, offsets);
+    DateColumn months{ dates };
+    AddMonths(months, offsets);
+    DateColumn years{ dates };
+    AddYears(years, offsets);
+    for(std::size_t i{}; i < dates.size(); ++i) {
+        Date month{ dates[i] };
+        month.AddMonths(offsets[i]);
+        ASSERT_EQ(months[i], month);
+        ASSERT_EQ(spanMonths[i], month);
+        Date year{ dates[i] };
+        year.AddYears(offsets[i]);
+        ASSERT_EQ(years[i], year);
+        ASSERT_EQ(spanYears[i], year);
+    }
+    EXPECT_THROW(AddMonths(months, std::span<const int>{ offsets }.first(1)), std::invalid_argument);
+}
+
+TEST(DateHistogram, Buckets) {
+    EXPECT_EQ(BucketStart(BucketOf(Date{ 2024, 1, 3 }, Period::Week), Period::Week), Date(2024, 1, 1));  // Monday.
+    EXPECT_EQ(BucketStart(BucketOf(Date{ 1969, 12, 28 }, Period::Week), Period::Week), Date(1969, 12, 22));
+    EXPECT_EQ(BucketStart(BucketOf(Date{ -1, 12, 31 }, Period::Month), Period::Month), Date(-1, 12, 1));
+    EXPECT_EQ(BucketStart(BucketOf(Date{ 2024, 5, 17 }, Period::Year), Period::Year), Date(2024, 1, 1));
+    EXPECT_EQ(BucketOf(Date{ 2024, 5, 17 }, Period::Day), Date(2024, 5, 17).ToDays());
+}
+
+TEST(DateHistogram, MatchesScalar) {
+    // A dense range of dates (and a sparse one, which takes the hashed path).
+    for(const std::int64_t stride : { std::int64_t{ 3 }, std::int64_t{ 4000 } }) {
+        std::vector<Date> dates;
+        std::vector<double> values;
+        for(std::int64_t i{}; i < 300000; ++i) {
+            dates.push_back(Date::CivilFromDays((i * 7919) % 100000 * stride - 50000));
+            values.push_back(static_cast<double>(i % 1000) - 500);
+        }
+        const DateColumn column{ dates };
+
+        for(const Period period : { Period::Day, Period::Week, Period::Month, Period::Year }) {
+            std::map<std::int64_t, BucketStats> expected;
+            for(std::size_t i{}; i < dates.size(); ++i) {
+                BucketStats& stats{ expected[BucketOf(dates[i], period)] };
+                stats.min = stats.count == 0 ? values[i] : std::min(stats.min, values[i]);
+                stats.max = stats.count == 0 ? values[i] : std::max(stats.max, values[i]);
+                stats.sum += values[i];
+                ++stats.count;
+            }
+
+            const std::vector<BucketStats> histogram{ Histogram(column, values, period) };
+            const std::vector<BucketStats> counts{ Histogram(column, period) };
+            ASSERT_EQ(histogram.size(), expected.size());
+            ASSERT_EQ(counts.size(), expected.size());
+            auto it{ expected.begin() };
+            for(std::size_t i{}; i < histogram.size(); ++i, ++it) {
+                ASSERT_EQ(histogram[i].bucket, it->first);
+                ASSERT_EQ(histogram[i].count, it->second.count);
+                ASSERT_DOUBLE_EQ(histogram[i].sum, it->second.sum);
+                ASSERT_EQ(histogram[i].min, it->second.min);
+                ASSERT_EQ(histogram[i].max, it->second.max);
+                ASSERT_EQ(counts[i].count, it->second.count);
+            }
+        }
+    }
+
+    const DateColumn column{ std::vector<Date>{ { 2024, 1, 1 } } };
+    std::vector<std::int64_t> out(2);
+    EXPECT_THROW(BucketOf(column, Period::Day, out), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(Histogram(column, std::vector<double>{}, Period::Day)), std::invalid_argument);
+}
+
+TEST(DateCodec, RoundTrip) {
+    // Sorted events with repeats, a few unsorted outliers, and a partial last block.
+    std::vector<Date> dates;
+    for(std::int64_t i{}; i < 10000; ++i)
+        dates.push_back(Date::CivilFromDays(i / 3 + (i % 997 == 0 ? -40000000 : 0)));
+    dates.push_back(Date{ 2024, 2, 29 });
+
+    std::stringstream stream;
+    DateColumnEncoder encoder{ stream };
+    encoder.Write(std::span<const Date>{ dates }.first(5000));
+    encoder.Write(DateColumn{ std::span<const Date>{ dates }.subspan(5000) });
+    encoder.Finish();
+    EXPECT_THROW(encoder.Write(Date{ 2024, 1, 1 }), std::logic_error);
+    EXPECT_EQ(encoder.BytesWritten(), stream.str().size());
+
+    DateColumnReader reader{ stream };
+    const DateColumn column{ reader.ReadAll() };
+    ASSERT_EQ(column.Size(), dates.size());
+    for(std::size_t i{}; i < dates.size(); ++i)
+        ASSERT_EQ(column[i], dates[i]);
+
+    std::istringstream garbage{ "not a column" };
+    EXPECT_THROW(DateColumnReader{ garbage }, std::runtime_error);
+    std::istringstream truncated{ stream.str().substr(0, 50) };
+    DateColumnReader truncatedReader{ truncated };
+    EXPECT_THROW(static_cast<void>(truncatedReader.ReadAll()), std::runtime_error);
+}
+
+TEST(DateCodec, ReadRangeSkipsBlocks) {
+    // Ten years of sorted events, 100 per day.
+    std::stringstream stream;
+    DateColumnEncoder encoder{ stream };
+    for(const Date& date : Days(Date{ 2015, 1, 1 }, Date{ 2025, 1, 1 })) {
+        for(int i{}; i < 100; ++i)
+            encoder.Write(date);
+    }
+    encoder.Finish();
+
+    DateColumnReader reader{ stream };
+    const DateColumn year{ reader.ReadRange(Date{ 2020, 1, 1 }, Date{ 2021, 1, 1 }) };
+    EXPECT_EQ(year.Size(), 36600U);
+    EXPECT_EQ(year[0], Date(2020, 1, 1));
+    EXPECT_EQ(year[year.Size() - 1], Date(2020, 12, 31));
+    EXPECT_GT(reader.BlocksSkipped(), 0U);
+    EXPECT_LT(encoder.BytesWritten(), 365 * 10 * 100);  // Less than a byte per date.
+    EXPECT_LT(reader.BytesRead() * 4, encoder.BytesWritten());
+}
+
+TEST(DateClass, ChronoInterop) {
+    using namespace std::chrono_literals;
+    static_assert(Date::FromYearMonthDay(2024y / std::chrono::February / 29) == Date{ 2024, 2, 29 });
+    static_assert(Date{ 1970, 1, 1 }.ToSysDays().time_since_epoch() == std::chrono::days{ 0 });
+    static_assert(Date{ 2024, 2, 28 } + std::chrono::days{ 2 } == Date{ 2024, 3, 1 });
+    static_assert(Date{ 2024, 3, 1 } - Date{ 2025, 3, 1 } == std::chrono::days{ -365 });
+
+    for(std::int64_t days{ -800000 }; days <= 800000; days += 97) {
+        const std::chrono::sys_days sysDays{ std::chrono::days{ days } };
+        const std::chrono::year_month_day ymd{ sysDays };
+        const Date date{ Date::FromSysDays(sysDays) };
+        ASSERT_EQ(date, Date::FromYearMonthDay(ymd));
+        ASSERT_EQ(date.ToYearMonthDay(), ymd);
+        ASSERT_EQ(date.ToSysDays(), sysDays);
+        ASSERT_EQ(std::chrono::days{ -days } + date, Date(1970, 1, 1));
+    }
+
+    Date date{ 2024, 1, 31 };
+    date += std::chrono::days{ 29 };
+    EXPECT_EQ(date, Date(2024, 2, 29));
+    date -= std::chrono::days{ -1 };
+    EXPECT_EQ(date, Date(2024, 3, 1));
+    EXPECT_EQ(date - std::chrono::weeks{ 1 }, Date(2024, 2, 23));
+
+    // std::chrono::year only holds -32767 to 32767.
+    EXPECT_EQ(Date(32767, 12, 31).ToYearMonthDay(), 32767y / std::chrono::December / 31);
+    EXPECT_EQ(Date(-32767, 1, 1).ToYearMonthDay(), -32767y / std::chrono::January / 1);
+    EXPECT_THROW(static_cast<void>(Date(32768, 1, 1).ToYearMonthDay()), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(Date(-40000, 1, 1).ToYearMonthDay()), std::out_of_range);
+}
+
 TEST(DateClass, IO) {
     std::stringstream ss;
 
@@ -21,17 +21,34 @@
 
 #pragma once
 
-#include <cstddef>    // std::size_t.
-#include <ostream>    // std::ostream.
-#include <stdexcept>  // std::runtime_error, std::invalid_argument, std::bad_alloc, std::out_of_range.
+#include <array>        // std::array.
+#include <cmath>        // std::sqrt.
+#include <cstddef>      // std::size_t.
+#include <cstdint>      // std::uint64_t.
+#include <future>       // std::async, std::future.
+#include <ostream>      // std::ostream.
+#include <stdexcept>    // std::runtime_error, std::invalid_argument, std::bad_alloc, std::out_of_range.
+#include <string>       // std::string, std::to_string.
+#include <thread>       // std::thread::hardware_concurrency.
+#include <type_traits>  // std::is_integral_v, std::is_signed_v, std::is_trivially_default_constructible_v, std::is_trivially_destructible_v.
+#include <utility>      // std::move, std::swap.
 
 namespace setm {
 
+// Packed matrix types (see packed.hpp) work directly on the dense storage.
+enum class Triangle;
+template<typename T>
+class SymmetricMatrix;
+template<typename T, Triangle Part>
+class TriangularMatrix;
+
 /**
  * @brief A class for working with matrices.
  *
  * This class provides functionality for creating, manipulating, and performing operations on matrices.
  * The matrices can be of different types, specified by the template parameter T.
+ * Small matrices of trivial element types (up to SMALL_BUFFER_CAPACITY elements) keep
+ * their elements inline and never touch the heap.
  */
 template<typename T>
 class Matrix {
@@ -142,6 +159,87 @@ public:
      */
     Matrix operator*(const Matrix& other) const;
 
+    /**
+     * @brief Raise the matrix to a power using binary exponentiation.
+     * @param exponent The exponent (zero gives the identity matrix).
+     * @return The matrix raised to the power.
+     * @throw std::runtime_error If the matrix is not square.
+     */
+    Matrix pow(std::uint64_t exponent) const;
+
+    /**
+     * @brief Raise the matrix to a power modulo a number.
+     * @param exponent The exponent (zero gives the identity matrix).
+     * @param modulus The modulus applied after every operation.
+     * @return The matrix raised to the power, with elements in [0, modulus).
+     * @throw std::runtime_error If the matrix is not square.
+     * @throw std::invalid_argument If the modulus is not positive.
+     */
+    Matrix pow(std::uint64_t exponent, T modulus) const
+        requires std::is_integral_v<T>;
+
+    /**
+     * @brief Apply a function to every element.
+     * @param func Callable taking an element and returning the new value.
+     * @return The matrix of transformed elements.
+     */
+    template<typename F>
+    Matrix map(F func) const;
+
+    /**
+     * @brief Combine the elements of two matrices pairwise.
+     * @param other The second operand (same dimensions as this matrix).
+     * @param func Callable taking an element of each matrix and returning the new value.
+     * @return The matrix of combined elements (e.g. the Hadamard product for multiplication).
+     * @throw std::runtime_error If matrix dimensions do not match.
+     */
+    template<typename F>
+    Matrix zipWith(const Matrix& other, F func) const;
+
+    /**
+     * @brief Fold all elements with an associative operation.
+     * @param init The initial value (applied once).
+     * @param op Associative callable combining two values.
+     * @return The result of the reduction (init for an empty matrix).
+     * @details Large matrices are reduced in parallel as a tree, so op may be called
+     *          concurrently from several threads and the order of combination is unspecified.
+     */
+    template<typename F>
+    T reduce(T init, F op) const;
+
+    /**
+     * @brief Get the sum of all elements.
+     * @return The sum (T{} for an empty matrix).
+     */
+    T sum() const;
+
+    /**
+     * @brief Get the smallest element.
+     * @return The smallest element.
+     * @throw std::runtime_error If the matrix is empty.
+     */
+    T min() const;
+
+    /**
+     * @brief Get the largest element.
+     * @return The largest element.
+     * @throw std::runtime_error If the matrix is empty.
+     */
+    T max() const;
+
+    /**
+     * @brief Get the Frobenius norm (square root of the sum of squared elements).
+     * @return The norm.
+     */
+    double norm() const;
+
+    /**
+     * @brief Get the trace (sum of the main diagonal elements).
+     * @return The trace.
+     * @throw std::runtime_error If the matrix is not square.
+     */
+    T trace() const;
+
     /**
      * @brief Equality comparison operator.
      * @param other The matrix to be compared.
@@ -173,6 +271,11 @@ public:
     }
 
 private:
+    template<typename>
+    friend class SymmetricMatrix;
+    template<typename, Triangle>
+    friend class TriangularMatrix;
+
     /**
      * @brief Helper function for comparing data.
      * @param other The matrix to be compared.
@@ -180,26 +283,109 @@ private:
      */
     bool compareData(const Matrix& other) const;
 
+    /**
+     * @brief Helper function for multiplying matrices into preallocated storage.
+     * @param lhs The left operand.
+     * @param rhs The right operand.
+     * @param result The destination (lhs.rows x rhs.cols, must not alias the operands).
+     */
+    static void multiplyInto(const Matrix& lhs, const Matrix& rhs, Matrix& result);
+
+    /**
+     * @brief Helper function for multiplying matrices modulo a number into preallocated storage.
+     * @details The operands must have their elements in [0, modulus).
+     */
+    static void multiplyModInto(const Matrix& lhs, const Matrix& rhs, Matrix& result, T modulus)
+        requires std::is_integral_v<T>;
+
+    /**
+     * @brief Helper function for computing (lhs * rhs) % modulus without overflow.
+     */
+    static T multiplyMod(T lhs, T rhs, T modulus)
+        requires std::is_integral_v<T>;
+
+    /**
+     * @brief Helper function for creating an identity matrix.
+     * @param size The number of rows (and columns).
+     * @param one The value of the diagonal elements.
+     */
+    static Matrix identity(std::size_t size, T one);
+
+    /**
+     * @brief Helper function for checking that the matrix is square.
+     * @param operation The name of the operation for the error message.
+     * @throw std::runtime_error If the matrix is not square.
+     */
+    void checkSquare(const char* operation) const;
+
+    /**
+     * @brief Helper function for reducing a non-empty range of elements.
+     * @param first Pointer to the first element.
+     * @param last Pointer past the last element.
+     * @param op Associative reduction operation.
+     * @param depth Remaining number of parallel splits.
+     * @return The result of the reduction.
+     */
+    template<typename F>
+    static T reduceRange(const T* first, const T* last, F& op, unsigned depth);
+
+    /**
+     * @brief Helper function for getting the number of parallel splits for a reduction.
+     * @return The splitting depth for the current hardware.
+     */
+    static unsigned reduceDepth();
+
+    /**
+     * @brief Helper function for getting storage for the matrix elements.
+     * @param size The number of elements.
+     * @return nullptr if size is zero, the inline buffer if the elements fit into it,
+     *         or a newly allocated array otherwise.
+     * @throw std::bad_alloc If memory allocation fails.
+     */
+    T* allocate(std::size_t size);
+
+    /**
+     * @brief Helper function for freeing the storage (if it was allocated dynamically).
+     */
+    void release() noexcept;
+
+    /**
+     * @brief Helper function for taking over the elements of another matrix.
+     * @param other The matrix to be moved from (left empty).
+     * @details Expects rows and cols to be already copied from other.
+     */
+    void steal(Matrix& other) noexcept;
+
+    // Ranges shorter than this are reduced sequentially.
+    static constexpr std::size_t PARALLEL_REDUCE_THRESHOLD{ 1 << 16 };
+
+    // Matrices with at most this many elements are stored inline, without heap allocation.
+    // Only trivial element types are: their inline buffer is left uninitialized, so it costs
+    // nothing to construct; other types would construct and destroy every inline element.
+    static constexpr std::size_t SMALL_BUFFER_CAPACITY{
+        std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T> ? 64 : 0
+    };
+
+    /**
+     * @brief Helper function for getting the inline buffer.
+     * @return The buffer, or nullptr if elements of type T are never stored inline.
+     */
+    T* inlineBuffer() noexcept;
+
     std::size_t rows{};  // Number of rows in the matrix.
     std::size_t cols{};  // Number of columns in the matrix.
-    T* data{ nullptr };  // Pointer to the dynamically allocated matrix data.
+    T* data{ nullptr };  // Pointer to the matrix data (either buffer or dynamically allocated).
+    [[no_unique_address]] std::array<T, SMALL_BUFFER_CAPACITY> buffer;  // Inline storage for small matrices.
 };
 
 
 template<typename T>
 Matrix<T>::Matrix(std::size_t rows, std::size_t cols, T defaultValue)
     : rows{ rows }, cols{ cols } {
-    if(rows > 0 && cols > 0) {
-        try {
-            data = new T[rows * cols];
-        } catch(const std::bad_alloc&) {
-            delete[] data;
-            throw;  // Rethrow the exception.
-        }
+    data = allocate(rows * cols);
 
-        for(std::size_t i{}; i < rows * cols; ++i) {
-            data[i] = defaultValue;
-        }
+    for(std::size_t i{}; i < rows * cols; ++i) {
+        data[i] = defaultValue;
     }
 }
 
@@ -210,12 +396,7 @@ Matrix<T>::Matrix(const T* const array, std::size_t rows, std::size_t cols)
         throw std::invalid_argument("Invalid input array or dimensions");
     }
 
-    try {
-        data = new T[rows * cols];
-    } catch(const std::bad_alloc&) {
-        delete[] data;
-        throw;  // Rethrow the exception.
-    }
+    data = allocate(rows * cols);
 
     for(std::size_t i{}; i < rows * cols; ++i) {
         data[i] = array[i];
@@ -224,18 +405,13 @@ Matrix<T>::Matrix(const T* const array, std::size_t rows, std::size_t cols)
 
 template<typename T>
 Matrix<T>::~Matrix() {
-    delete[] data;
+    release();
 }
 
 template<typename T>
 Matrix<T>::Matrix(const Matrix& other)
     : rows{ other.rows }, cols{ other.cols } {
-    try {
-        data = new T[rows * cols];
-    } catch(const std::bad_alloc&) {
-        delete[] data;
-        throw;  // Rethrow the exception.
-    }
+    data = allocate(rows * cols);
 
     for(std::size_t i{}; i < rows * cols; ++i) {
         data[i] = other.data[i];
@@ -244,27 +420,23 @@ Matrix<T>::Matrix(const Matrix& other)
 
 template<typename T>
 Matrix<T>::Matrix(Matrix&& other) noexcept
-    : rows{ other.rows }, cols{ other.cols }, data{ other.data } {
-    other.rows = 0;
-    other.cols = 0;
-    other.data = nullptr;
+    : rows{ other.rows }, cols{ other.cols } {
+    steal(other);
 }
 
 template<typename T>
 Matrix<T>& Matrix<T>::operator=(const Matrix& other) {
     if(this != &other) {
-        delete[] data;
+        // The current storage is reused when the number of elements does not change.
+        if(rows * cols != other.rows * other.cols) {
+            T* storage{ allocate(other.rows * other.cols) };
+            release();
+            data = storage;
+        }
 
         rows = other.rows;
         cols = other.cols;
 
-        try {
-            data = new T[rows * cols];
-        } catch(const std::bad_alloc&) {
-            delete[] data;
-            throw;  // Rethrow the exception.
-        }
-
         for(std::size_t i = 0; i < rows * cols; ++i) {
             data[i] = other.data[i];
         }
@@ -275,19 +447,60 @@ Matrix<T>& Matrix<T>::operator=(const Matrix& other) {
 template<typename T>
 Matrix<T>& Matrix<T>::operator=(Matrix&& other) noexcept {
     if(this != &other) {
-        delete[] data;
+        release();
 
         rows = other.rows;
         cols = other.cols;
-        data = other.data;
-
-        other.rows = 0;
-        other.cols = 0;
-        other.data = nullptr;
+        steal(other);
     }
     return *this;
 }
 
+template<typename T>
+T* Matrix<T>::allocate(std::size_t size) {
+    if(size == 0) {
+        return nullptr;
+    }
+    if(size <= SMALL_BUFFER_CAPACITY) {
+        return inlineBuffer();
+    }
+    return new T[size];
+}
+
+template<typename T>
+T* Matrix<T>::inlineBuffer() noexcept {
+    if constexpr(SMALL_BUFFER_CAPACITY == 0) {
+        return nullptr;
+    } else {
+        return buffer.data();
+    }
+}
+
+template<typename T>
+void Matrix<T>::release() noexcept {
+    if(data != inlineBuffer()) {
+        delete[] data;
+    }
+    data = nullptr;
+}
+
+template<typename T>
+void Matrix<T>::steal(Matrix& other) noexcept {
+    if(other.data == other.inlineBuffer()) {
+        // Inline elements cannot be handed over, so they are moved one by one.
+        for(std::size_t i{}; i < rows * cols; ++i) {
+            buffer[i] = std::move(other.buffer[i]);
+        }
+        data = inlineBuffer();
+    } else {
+        data = other.data;
+    }
+
+    other.rows = 0;
+    other.cols = 0;
+    other.data = nullptr;
+}
+
 template<typename T>
 std::size_t Matrix<T>::getRows() const {
     return rows;
@@ -365,13 +578,297 @@ Matrix<T> Matrix<T>::operator*(const Matrix& other) const {
     }
 
     Matrix<T> result{ rows, other.cols };
-    for(std::size_t i{}; i < rows; ++i) {
-        for(std::size_t j{}; j < other.cols; ++j) {
-            result.data[i * other.cols + j] = 0;
-            for(std::size_t k{}; k < cols; ++k) {
-                result.data[i * other.cols + j] += data[i * cols + k] * other.data[k * other.cols + j];
+    multiplyInto(*this, other, result);
+    return result;
+}
+
+template<typename T>
+void Matrix<T>::multiplyInto(const Matrix& lhs, const Matrix& rhs, Matrix& result) {
+    for(std::size_t i{}; i < lhs.rows; ++i) {
+        for(std::size_t j{}; j < rhs.cols; ++j) {
+            result.data[i * rhs.cols + j] = 0;
+            for(std::size_t k{}; k < lhs.cols; ++k) {
+                result.data[i * rhs.cols + j] += lhs.data[i * lhs.cols + k] * rhs.data[k * rhs.cols + j];
+            }
+        }
+    }
+}
+
+template<typename T>
+void Matrix<T>::multiplyModInto(const Matrix& lhs, const Matrix& rhs, Matrix& result, T modulus)
+    requires std::is_integral_v<T>
+{
+    for(std::size_t i{}; i < lhs.rows; ++i) {
+        for(std::size_t j{}; j < rhs.cols; ++j) {
+            T sum{};
+            for(std::size_t k{}; k < lhs.cols; ++k) {
+                const T product{ multiplyMod(lhs.data[i * lhs.cols + k], rhs.data[k * rhs.cols + j], modulus) };
+                // (sum + product) % modulus without overflowing T.
+                sum = sum >= modulus - product ? sum - (modulus - product) : sum + product;
+            }
+            result.data[i * rhs.cols + j] = sum;
+        }
+    }
+}
+
+template<typename T>
+T Matrix<T>::multiplyMod(T lhs, T rhs, T modulus)
+    requires std::is_integral_v<T>
+{
+#if defined(__SIZEOF_INT128__)
+    return static_cast<T>(static_cast<unsigned __int128>(lhs) * static_cast<unsigned __int128>(rhs) % static_cast<unsigned __int128>(modulus));
+#else
+    // Double-and-add multiplication for compilers without 128-bit integers.
+    unsigned long long a{ static_cast<unsigned long long>(lhs) };
+    unsigned long long b{ static_cast<unsigned long long>(rhs) };
+    const unsigned long long m{ static_cast<unsigned long long>(modulus) };
+    unsigned long long result{};
+    while(b > 0) {
+        if(b & 1) {
+            result = result >= m - a ? result - (m - a) : result + a;
+        }
+        a = a >= m - a ? a - (m - a) : a + a;
+        b >>= 1;
+    }
+    return static_cast<T>(result);
+#endif
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::pow(std::uint64_t exponent) const {
+    checkSquare("exponentiation");
+
+    Matrix<T> base{ *this };
+    Matrix<T> spare{ rows, cols };
+    Matrix<T> accumulator{ identity(rows, T{ 1 }) };
+    Matrix<T> baseSpare{ rows, cols };
+
+    // The products are written into the spare buffers, then the roles are swapped.
+    Matrix<T>* acc{ &accumulator };
+    Matrix<T>* accSpare{ &spare };
+    Matrix<T>* power{ &base };
+    Matrix<T>* powerSpare{ &baseSpare };
+    while(exponent > 0) {
+        if(exponent & 1) {
+            multiplyInto(*acc, *power, *accSpare);
+            std::swap(acc, accSpare);
+        }
+        exponent >>= 1;
+        if(exponent > 0) {
+            multiplyInto(*power, *power, *powerSpare);
+            std::swap(power, powerSpare);
+        }
+    }
+    return std::move(*acc);
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::pow(std::uint64_t exponent, T modulus) const
+    requires std::is_integral_v<T>
+{
+    checkSquare("exponentiation");
+    if(!(modulus > 0)) {
+        throw std::invalid_argument("Modulus must be positive");
+    }
+
+    Matrix<T> base{ rows, cols };
+    for(std::size_t i{}; i < rows * cols; ++i) {
+        // Bring (possibly negative) elements into [0, modulus).
+        T remainder{ static_cast<T>(data[i] % modulus) };
+        if constexpr(std::is_signed_v<T>) {
+            if(remainder < 0) {
+                remainder += modulus;
             }
         }
+        base.data[i] = remainder;
+    }
+    Matrix<T> spare{ rows, cols };
+    Matrix<T> accumulator{ identity(rows, static_cast<T>(1 % modulus)) };
+    Matrix<T> baseSpare{ rows, cols };
+
+    Matrix<T>* acc{ &accumulator };
+    Matrix<T>* accSpare{ &spare };
+    Matrix<T>* power{ &base };
+    Matrix<T>* powerSpare{ &baseSpare };
+    while(exponent > 0) {
+        if(exponent & 1) {
+            multiplyModInto(*acc, *power, *accSpare, modulus);
+            std::swap(acc, accSpare);
+        }
+        exponent >>= 1;
+        if(exponent > 0) {
+            multiplyModInto(*power, *power, *powerSpare, modulus);
+            std::swap(power, powerSpare);
+        }
+    }
+    return std::move(*acc);
+}
+
+template<typename T>
+Matrix<T> Matrix<T>::identity(std::size_t size, T one) {
+    Matrix<T> result{ size, size, T{} };
+    for(std::size_t i{}; i < size; ++i) {
+        result.data[i * size + i] = one;
+    }
+    return result;
+}
+
+template<typename T>
+void Matrix<T>::checkSquare(const char* operation) const {
+    if(rows != cols) {
+        throw std::runtime_error(std::string{ "Matrix must be square for " } +
+                                 operation +
+                                 " (" +
+                                 std::to_string(rows) +
+                                 "x" +
+                                 std::to_string(cols) +
+                                 ")");
+    }
+}
+
+template<typename T>
+Matrix<T> pow(const Matrix<T>& base, std::uint64_t exponent) {
+    return base.pow(exponent);
+}
+
+template<typename T>
+    requires std::is_integral_v<T>
+Matrix<T> pow(const Matrix<T>& base, std::uint64_t exponent, T modulus) {
+    return base.pow(exponent, modulus);
+}
+
+template<typename T>
+template<typename F>
+Matrix<T> Matrix<T>::map(F func) const {
+    Matrix<T> result{ rows, cols };
+    const std::size_t size{ rows * cols };
+    for(std::size_t i{}; i < size; ++i) {
+        result.data[i] = func(data[i]);
+    }
+    return result;
+}
+
+template<typename T>
+template<typename F>
+Matrix<T> Matrix<T>::zipWith(const Matrix& other, F func) const {
+    if(rows != other.rows || cols != other.cols) {
+        throw std::runtime_error("Matrix dimensions do not match for element-wise operation (" +
+                                 std::to_string(rows) +
+                                 "x" +
+                                 std::to_string(cols) +
+                                 " and " +
+                                 std::to_string(other.rows) +
+                                 "x" +
+                                 std::to_string(other.cols) +
+                                 ")");
+    }
+
+    Matrix<T> result{ rows, cols };
+    const std::size_t size{ rows * cols };
+    for(std::size_t i{}; i < size; ++i) {
+        result.data[i] = func(data[i], other.data[i]);
+    }
+    return result;
+}
+
+template<typename T>
+template<typename F>
+T Matrix<T>::reduce(T init, F op) const {
+    if(rows * cols == 0) {
+        return init;
+    }
+    return op(init, reduceRange(data, data + rows * cols, op, reduceDepth()));
+}
+
+template<typename T>
+template<typename F>
+T Matrix<T>::reduceRange(const T* first, const T* last, F& op, unsigned depth) {
+    const std::size_t size{ static_cast<std::size_t>(last - first) };
+
+    if(depth > 0 && size >= 2 * PARALLEL_REDUCE_THRESHOLD) {
+        // Split the range in halves and reduce the right half on another thread.
+        const T* middle{ first + size / 2 };
+        std::future<T> right{ std::async(std::launch::async, [middle, last, &op, depth] {
+            return reduceRange(middle, last, op, depth - 1);
+        }) };
+        const T left{ reduceRange(first, middle, op, depth - 1) };
+        return op(left, right.get());
+    }
+
+    // Independent accumulators break the dependency chain so the loop can be vectorized.
+    if(size < 4) {
+        T acc{ first[0] };
+        for(std::size_t i{ 1 }; i < size; ++i) {
+            acc = op(acc, first[i]);
+        }
+        return acc;
+    }
+
+    T acc0{ first[0] };
+    T acc1{ first[1] };
+    T acc2{ first[2] };
+    T acc3{ first[3] };
+    std::size_t i{ 4 };
+    for(; i + 4 <= size; i += 4) {
+        acc0 = op(acc0, first[i]);
+        acc1 = op(acc1, first[i + 1]);
+        acc2 = op(acc2, first[i + 2]);
+        acc3 = op(acc3, first[i + 3]);
+    }
+    for(; i < size; ++i) {
+        acc0 = op(acc0, first[i]);
+    }
+    return op(op(acc0, acc1), op(acc2, acc3));
+}
+
+template<typename T>
+unsigned Matrix<T>::reduceDepth() {
+    unsigned depth{};
+    for(unsigned threads{ std::thread::hardware_concurrency() }; threads > 1; threads /= 2) {
+        ++depth;
+    }
+    return depth;
+}
+
+template<typename T>
+T Matrix<T>::sum() const {
+    return reduce(T{}, [](const T& lhs, const T& rhs) { return lhs + rhs; });
+}
+
+template<typename T>
+T Matrix<T>::min() const {
+    if(rows * cols == 0) {
+        throw std::runtime_error("Cannot get the minimum of an empty matrix");
+    }
+    return reduce(data[0], [](const T& lhs, const T& rhs) { return rhs < lhs ? rhs : lhs; });
+}
+
+template<typename T>
+T Matrix<T>::max() const {
+    if(rows * cols == 0) {
+        throw std::runtime_error("Cannot get the maximum of an empty matrix");
+    }
+    return reduce(data[0], [](const T& lhs, const T& rhs) { return lhs < rhs ? rhs : lhs; });
+}
+
+template<typename T>
+double Matrix<T>::norm() const {
+    double squares{};
+    const std::size_t size{ rows * cols };
+    for(std::size_t i{}; i < size; ++i) {
+        const double value{ static_cast<double>(data[i]) };
+        squares += value * value;
+    }
+    return std::sqrt(squares);
+}
+
+template<typename T>
+T Matrix<T>::trace() const {
+    checkSquare("trace");
+
+    T result{};
+    for(std::size_t i{}; i < rows; ++i) {
+        result += data[i * cols + i];
     }
     return result;
 }
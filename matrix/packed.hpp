@@ -0,0 +1,484 @@
+/**
+ * @file packed.hpp
+ * @brief Packed storage for symmetric and triangular square matrices.
+ *
+ * Only one triangle of the matrix (n * (n + 1) / 2 elements) is stored, row by row.
+ * Multiplication by a dense Matrix reads every stored element exactly once
+ * (SYMM / TRMM style kernels), and both types convert to and from a dense Matrix.
+ */
+
+#pragma once
+
+#include <cstddef>    // std::size_t.
+#include <ostream>    // std::ostream.
+#include <stdexcept>  // std::runtime_error, std::invalid_argument, std::bad_alloc, std::out_of_range.
+#include <string>     // std::to_string.
+
+#include "matrix.hpp"  // setm::Matrix.
+
+namespace setm {
+
+/**
+ * @brief The triangle of a square matrix that holds the non-zero elements.
+ */
+enum class Triangle { Upper, Lower };
+
+/**
+ * @brief Memory management shared by the packed matrix types.
+ *
+ * Holds n * (n + 1) / 2 elements; the layout is defined by the derived class.
+ */
+template<typename T>
+class PackedStorage {
+public:
+    /**
+     * @brief Get the number of rows (and columns) in the matrix.
+     * @return The size of the matrix.
+     */
+    std::size_t getSize() const;
+
+    /**
+     * @brief Get the number of stored elements.
+     * @return n * (n + 1) / 2.
+     */
+    std::size_t getPackedSize() const;
+
+protected:
+    /**
+     * @brief Constructor.
+     * @param size The number of rows (and columns) in the matrix.
+     * @param defaultValue The default value for the stored elements.
+     * @throw std::bad_alloc If memory allocation fails for a non-empty matrix.
+     */
+    explicit PackedStorage(std::size_t size = {}, T defaultValue = T{});
+
+    PackedStorage(const PackedStorage& other);
+    PackedStorage(PackedStorage&& other) noexcept;
+    ~PackedStorage();
+    PackedStorage& operator=(const PackedStorage& other);
+    PackedStorage& operator=(PackedStorage&& other) noexcept;
+
+    /**
+     * @brief Helper function for validating the dimensions of a dense operand.
+     * @param rows The number of rows in the operand.
+     * @param cols The number of columns in the operand.
+     * @throw std::runtime_error If the operand cannot be multiplied by this matrix.
+     */
+    void checkMultiplication(std::size_t rows, std::size_t cols) const;
+
+    std::size_t size{};  // Number of rows (and columns) in the matrix.
+    T* data{ nullptr };  // Pointer to the dynamically allocated packed triangle.
+};
+
+/**
+ * @brief A symmetric square matrix storing its lower triangle only.
+ */
+template<typename T>
+class SymmetricMatrix : public PackedStorage<T> {
+public:
+    /**
+     * @brief Default constructor.
+     * @param size The number of rows (and columns) in the matrix.
+     * @param defaultValue The default value for matrix elements.
+     * @throw std::bad_alloc If memory allocation fails for a non-empty matrix.
+     */
+    explicit SymmetricMatrix(std::size_t size = {}, T defaultValue = T{});
+
+    /**
+     * @brief Constructor to initialize the matrix from a dense one.
+     * @param dense The dense matrix; only its lower triangle is read.
+     * @throw std::invalid_argument If the dense matrix is not square.
+     */
+    explicit SymmetricMatrix(const Matrix<T>& dense);
+
+    /**
+     * @brief Get the element at the specified row and column.
+     * @throws std::out_of_range If the provided indices are out of bounds.
+     */
+    T getElement(std::size_t row, std::size_t col) const;
+
+    /**
+     * @brief Set the element at the specified row and column (and its mirror).
+     * @throws std::out_of_range If the provided indices are out of bounds.
+     */
+    void setElement(std::size_t row, std::size_t col, T value);
+
+    /**
+     * @brief Convert to a dense matrix.
+     * @return The dense matrix with both triangles filled.
+     */
+    Matrix<T> toMatrix() const;
+
+    /**
+     * @brief Multiply by a dense matrix (SYMM).
+     * @param other The dense matrix to be multiplied.
+     * @return The result of the multiplication.
+     * @throw std::runtime_error If matrix dimensions do not match for multiplication.
+     */
+    Matrix<T> operator*(const Matrix<T>& other) const;
+
+    /**
+     * @brief Overloaded stream output operator to print the matrix.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const SymmetricMatrix& matrix) {
+        return os << matrix.toMatrix();
+    }
+
+private:
+    /**
+     * @brief Helper function for getting the packed index of a lower-triangle element.
+     */
+    static std::size_t index(std::size_t row, std::size_t col);
+};
+
+/**
+ * @brief A triangular square matrix storing the non-zero triangle only.
+ *
+ * Elements outside of the stored triangle are zero.
+ */
+template<typename T, Triangle Part>
+class TriangularMatrix : public PackedStorage<T> {
+public:
+    /**
+     * @brief Default constructor.
+     * @param size The number of rows (and columns) in the matrix.
+     * @param defaultValue The default value for the stored elements.
+     * @throw std::bad_alloc If memory allocation fails for a non-empty matrix.
+     */
+    explicit TriangularMatrix(std::size_t size = {}, T defaultValue = T{});
+
+    /**
+     * @brief Constructor to initialize the matrix from a dense one.
+     * @param dense The dense matrix; only the stored triangle is read.
+     * @throw std::invalid_argument If the dense matrix is not square.
+     */
+    explicit TriangularMatrix(const Matrix<T>& dense);
+
+    /**
+     * @brief Get the element at the specified row and column.
+     * @return The element, or T{} outside of the stored triangle.
+     * @throws std::out_of_range If the provided indices are out of bounds.
+     */
+    T getElement(std::size_t row, std::size_t col) const;
+
+    /**
+     * @brief Set the element at the specified row and column.
+     * @throws std::out_of_range If the indices are out of bounds or outside of the stored triangle.
+     */
+    void setElement(std::size_t row, std::size_t col, T value);
+
+    /**
+     * @brief Convert to a dense matrix.
+     * @return The dense matrix with zeros outside of the stored triangle.
+     */
+    Matrix<T> toMatrix() const;
+
+    /**
+     * @brief Multiply by a dense matrix (TRMM).
+     * @param other The dense matrix to be multiplied.
+     * @return The result of the multiplication.
+     * @throw std::runtime_error If matrix dimensions do not match for multiplication.
+     */
+    Matrix<T> operator*(const Matrix<T>& other) const;
+
+    /**
+     * @brief Overloaded stream output operator to print the matrix.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const TriangularMatrix& matrix) {
+        return os << matrix.toMatrix();
+    }
+
+private:
+    /**
+     * @brief Helper function for checking if an element belongs to the stored triangle.
+     */
+    static bool isStored(std::size_t row, std::size_t col);
+
+    /**
+     * @brief Helper function for getting the packed index of a stored element.
+     */
+    std::size_t index(std::size_t row, std::size_t col) const;
+};
+
+template<typename T>
+using UpperTriangularMatrix = TriangularMatrix<T, Triangle::Upper>;
+
+template<typename T>
+using LowerTriangularMatrix = TriangularMatrix<T, Triangle::Lower>;
+
+
+template<typename T>
+PackedStorage<T>::PackedStorage(std::size_t size, T defaultValue)
+    : size{ size } {
+    if(size > 0) {
+        data = new T[getPackedSize()];
+
+        for(std::size_t i{}; i < getPackedSize(); ++i) {
+            data[i] = defaultValue;
+        }
+    }
+}
+
+template<typename T>
+PackedStorage<T>::PackedStorage(const PackedStorage& other)
+    : size{ other.size } {
+    if(size > 0) {
+        data = new T[getPackedSize()];
+
+        for(std::size_t i{}; i < getPackedSize(); ++i) {
+            data[i] = other.data[i];
+        }
+    }
+}
+
+template<typename T>
+PackedStorage<T>::PackedStorage(PackedStorage&& other) noexcept
+    : size{ other.size }, data{ other.data } {
+    other.size = 0;
+    other.data = nullptr;
+}
+
+template<typename T>
+PackedStorage<T>::~PackedStorage() {
+    delete[] data;
+}
+
+template<typename T>
+PackedStorage<T>& PackedStorage<T>::operator=(const PackedStorage& other) {
+    if(this != &other) {
+        T* copy{ other.size > 0 ? new T[other.getPackedSize()] : nullptr };
+        for(std::size_t i{}; i < other.getPackedSize(); ++i) {
+            copy[i] = other.data[i];
+        }
+
+        delete[] data;
+        size = other.size;
+        data = copy;
+    }
+    return *this;
+}
+
+template<typename T>
+PackedStorage<T>& PackedStorage<T>::operator=(PackedStorage&& other) noexcept {
+    if(this != &other) {
+        delete[] data;
+
+        size = other.size;
+        data = other.data;
+
+        other.size = 0;
+        other.data = nullptr;
+    }
+    return *this;
+}
+
+template<typename T>
+std::size_t PackedStorage<T>::getSize() const {
+    return size;
+}
+
+template<typename T>
+std::size_t PackedStorage<T>::getPackedSize() const {
+    return size * (size + 1) / 2;
+}
+
+template<typename T>
+void PackedStorage<T>::checkMultiplication(std::size_t rows, std::size_t cols) const {
+    if(size != rows) {
+        throw std::runtime_error("Matrix dimensions do not match for multiplication (" +
+                                 std::to_string(size) +
+                                 "x" +
+                                 std::to_string(size) +
+                                 " and " +
+                                 std::to_string(rows) +
+                                 "x" +
+                                 std::to_string(cols) +
+                                 ")");
+    }
+}
+
+
+template<typename T>
+SymmetricMatrix<T>::SymmetricMatrix(std::size_t size, T defaultValue)
+    : PackedStorage<T>{ size, defaultValue } {}
+
+template<typename T>
+SymmetricMatrix<T>::SymmetricMatrix(const Matrix<T>& dense)
+    : PackedStorage<T>{ dense.getRows() } {
+    if(dense.getRows() != dense.getCols()) {
+        throw std::invalid_argument("Symmetric matrix must be square");
+    }
+
+    for(std::size_t i{}; i < this->size; ++i) {
+        for(std::size_t j{}; j <= i; ++j) {
+            this->data[index(i, j)] = dense.data[i * this->size + j];
+        }
+    }
+}
+
+template<typename T>
+std::size_t SymmetricMatrix<T>::index(std::size_t row, std::size_t col) {
+    // Mirror the upper triangle onto the stored lower one.
+    if(row < col) {
+        const std::size_t tmp{ row };
+        row = col;
+        col = tmp;
+    }
+    return row * (row + 1) / 2 + col;
+}
+
+template<typename T>
+T SymmetricMatrix<T>::getElement(std::size_t row, std::size_t col) const {
+    if(row >= this->size || col >= this->size) {
+        throw std::out_of_range("Matrix indices out of bounds");
+    }
+
+    return this->data[index(row, col)];
+}
+
+template<typename T>
+void SymmetricMatrix<T>::setElement(std::size_t row, std::size_t col, T value) {
+    if(row >= this->size || col >= this->size) {
+        throw std::out_of_range("Matrix indices out of bounds");
+    }
+
+    this->data[index(row, col)] = value;
+}
+
+template<typename T>
+Matrix<T> SymmetricMatrix<T>::toMatrix() const {
+    const std::size_t n{ this->size };
+    Matrix<T> result{ n, n };
+    const T* packed{ this->data };
+    for(std::size_t i{}; i < n; ++i) {
+        for(std::size_t j{}; j <= i; ++j, ++packed) {
+            result.data[i * n + j] = *packed;
+            result.data[j * n + i] = *packed;
+        }
+    }
+    return result;
+}
+
+template<typename T>
+Matrix<T> SymmetricMatrix<T>::operator*(const Matrix<T>& other) const {
+    this->checkMultiplication(other.rows, other.cols);
+
+    const std::size_t n{ this->size };
+    const std::size_t m{ other.cols };
+    Matrix<T> result{ n, m, T{} };
+    const T* packed{ this->data };
+    for(std::size_t i{}; i < n; ++i) {
+        T* resultRow{ result.data + i * m };
+        const T* otherRow{ other.data + i * m };
+        for(std::size_t j{}; j <= i; ++j, ++packed) {
+            // The stored element a(i, j) also stands for its mirror a(j, i).
+            const T value{ *packed };
+            const T* otherRowJ{ other.data + j * m };
+            for(std::size_t k{}; k < m; ++k) {
+                resultRow[k] += value * otherRowJ[k];
+            }
+            if(j != i) {
+                T* resultRowJ{ result.data + j * m };
+                for(std::size_t k{}; k < m; ++k) {
+                    resultRowJ[k] += value * otherRow[k];
+                }
+            }
+        }
+    }
+    return result;
+}
+
+
+template<typename T, Triangle Part>
+TriangularMatrix<T, Part>::TriangularMatrix(std::size_t size, T defaultValue)
+    : PackedStorage<T>{ size, defaultValue } {}
+
+template<typename T, Triangle Part>
+TriangularMatrix<T, Part>::TriangularMatrix(const Matrix<T>& dense)
+    : PackedStorage<T>{ dense.getRows() } {
+    if(dense.getRows() != dense.getCols()) {
+        throw std::invalid_argument("Triangular matrix must be square");
+    }
+
+    for(std::size_t i{}; i < this->size; ++i) {
+        for(std::size_t j{}; j < this->size; ++j) {
+            if(isStored(i, j)) {
+                this->data[index(i, j)] = dense.data[i * this->size + j];
+            }
+        }
+    }
+}
+
+template<typename T, Triangle Part>
+bool TriangularMatrix<T, Part>::isStored(std::size_t row, std::size_t col) {
+    return Part == Triangle::Lower ? col <= row : row <= col;
+}
+
+template<typename T, Triangle Part>
+std::size_t TriangularMatrix<T, Part>::index(std::size_t row, std::size_t col) const {
+    if constexpr(Part == Triangle::Lower) {
+        return row * (row + 1) / 2 + col;
+    } else {
+        // Rows 0..row-1 hold n, n-1, ..., n-row+1 elements.
+        return row * this->size - row * (row - 1) / 2 + (col - row);
+    }
+}
+
+template<typename T, Triangle Part>
+T TriangularMatrix<T, Part>::getElement(std::size_t row, std::size_t col) const {
+    if(row >= this->size || col >= this->size) {
+        throw std::out_of_range("Matrix indices out of bounds");
+    }
+
+    return isStored(row, col) ? this->data[index(row, col)] : T{};
+}
+
+template<typename T, Triangle Part>
+void TriangularMatrix<T, Part>::setElement(std::size_t row, std::size_t col, T value) {
+    if(row >= this->size || col >= this->size || !isStored(row, col)) {
+        throw std::out_of_range("Matrix indices out of bounds of the stored triangle");
+    }
+
+    this->data[index(row, col)] = value;
+}
+
+template<typename T, Triangle Part>
+Matrix<T> TriangularMatrix<T, Part>::toMatrix() const {
+    const std::size_t n{ this->size };
+    Matrix<T> result{ n, n, T{} };
+    const T* packed{ this->data };
+    for(std::size_t i{}; i < n; ++i) {
+        const std::size_t first{ Part == Triangle::Lower ? 0 : i };
+        const std::size_t last{ Part == Triangle::Lower ? i + 1 : n };
+        for(std::size_t j{ first }; j < last; ++j, ++packed) {
+            result.data[i * n + j] = *packed;
+        }
+    }
+    return result;
+}
+
+template<typename T, Triangle Part>
+Matrix<T> TriangularMatrix<T, Part>::operator*(const Matrix<T>& other) const {
+    this->checkMultiplication(other.rows, other.cols);
+
+    const std::size_t n{ this->size };
+    const std::size_t m{ other.cols };
+    Matrix<T> result{ n, m, T{} };
+    const T* packed{ this->data };
+    for(std::size_t i{}; i < n; ++i) {
+        T* resultRow{ result.data + i * m };
+        // Only the stored part of row i contributes to the product.
+        const std::size_t first{ Part == Triangle::Lower ? 0 : i };
+        const std::size_t last{ Part == Triangle::Lower ? i + 1 : n };
+        for(std::size_t j{ first }; j < last; ++j, ++packed) {
+            const T value{ *packed };
+            const T* otherRow{ other.data + j * m };
+            for(std::size_t k{}; k < m; ++k) {
+                resultRow[k] += value * otherRow[k];
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace setm
@@ -0,0 +1,332 @@
+/**
+ * @file task_graph.hpp
+ * @brief Deferred execution of Matrix operations as a task graph.
+ *
+ * Operations (addition, multiplication, transposition) are recorded as nodes of a
+ * directed acyclic graph instead of being evaluated immediately. The graph is then
+ * executed by a pool of worker threads: independent nodes run concurrently, and an
+ * intermediate result is released as soon as its last consumer has finished.
+ */
+
+#pragma once
+
+#include <atomic>              // std::atomic.
+#include <condition_variable>  // std::condition_variable.
+#include <cstddef>             // std::size_t.
+#include <cstdint>             // std::uint64_t.
+#include <deque>               // std::deque.
+#include <exception>           // std::exception_ptr, std::current_exception.
+#include <future>              // std::future, std::promise.
+#include <initializer_list>    // std::initializer_list.
+#include <mutex>               // std::mutex, std::unique_lock.
+#include <optional>            // std::optional.
+#include <stdexcept>           // std::invalid_argument, std::logic_error.
+#include <thread>              // std::thread.
+#include <utility>             // std::move.
+#include <vector>              // std::vector.
+
+#include "matrix.hpp"  // setm::Matrix.
+
+namespace setm {
+
+/**
+ * @brief A graph of deferred matrix operations.
+ *
+ * Usage:
+ * @code
+ * TaskGraph<double> graph;
+ * const auto a{ graph.input(m1) };
+ * const auto b{ graph.input(m2) };
+ * auto result{ graph.result(graph.add(graph.multiply(a, b), graph.transpose(a))) };
+ * graph.run();
+ * const Matrix<double> value{ result.get() };
+ * @endcode
+ *
+ * Only nodes passed to result() keep their value after the graph has been run.
+ * A graph can be run only once.
+ */
+template<typename T>
+class TaskGraph {
+public:
+    /**
+     * @brief Lightweight handle to a node of the graph.
+     */
+    class Node {
+    public:
+        Node() = default;
+
+    private:
+        friend class TaskGraph;
+
+        Node(std::uint64_t graph, std::size_t id)
+            : graph_{ graph }, id_{ id } {}
+
+        std::uint64_t graph_{};  // Id of the owning graph (0 for default-constructed handles).
+        std::size_t id_{};
+    };
+
+    /**
+     * @brief Add an input matrix to the graph.
+     * @param matrix The matrix value (copied or moved into the graph).
+     * @return Handle to the new node.
+     */
+    Node input(Matrix<T> matrix);
+
+    /**
+     * @brief Record a deferred matrix addition.
+     * @return Handle to the node that will hold lhs + rhs.
+     * @throw std::invalid_argument If a handle does not belong to the graph.
+     */
+    Node add(Node lhs, Node rhs);
+
+    /**
+     * @brief Record a deferred matrix multiplication.
+     * @return Handle to the node that will hold lhs * rhs.
+     * @throw std::invalid_argument If a handle does not belong to the graph.
+     */
+    Node multiply(Node lhs, Node rhs);
+
+    /**
+     * @brief Record a deferred matrix transposition.
+     * @return Handle to the node that will hold the transposed operand.
+     * @throw std::invalid_argument If the handle does not belong to the graph.
+     */
+    Node transpose(Node operand);
+
+    /**
+     * @brief Request the value of a node.
+     * @param node The node whose value is required after execution.
+     * @return A future that becomes ready as soon as the node has been computed.
+     *         If the operation (or one of its inputs) throws, the future holds the exception.
+     * @throw std::invalid_argument If the handle does not belong to the graph.
+     * @throw std::future_error If the result of the node has already been requested.
+     * @throw std::logic_error If the graph has already been run.
+     */
+    std::future<Matrix<T>> result(Node node);
+
+    /**
+     * @brief Execute the graph and block until every node has been processed.
+     * @param threads The number of worker threads (at least one is used).
+     * @throw std::logic_error If the graph has already been run.
+     */
+    void run(std::size_t threads = std::thread::hardware_concurrency());
+
+    /**
+     * @brief Get the number of nodes in the graph.
+     * @return The number of nodes.
+     */
+    std::size_t size() const;
+
+private:
+    enum class Operation { Input, Add, Multiply, Transpose };
+
+    struct NodeData {
+        Operation operation{ Operation::Input };
+        std::size_t operands[2]{};             // Indices of the operand nodes.
+        std::size_t operandCount{};            // Number of used entries in operands.
+        std::vector<std::size_t> dependents;   // Nodes that consume this node's value.
+        std::size_t pendingOperands{};         // Operands that are not computed yet.
+        std::size_t remainingConsumers{};      // Dependents that have not finished yet.
+        std::optional<Matrix<T>> value;        // Computed value (released when no longer needed).
+        std::exception_ptr error;              // Exception thrown while computing the node.
+        std::optional<std::promise<Matrix<T>>> promise;  // Set if the value was requested.
+    };
+
+    Node addNode(Operation operation, std::initializer_list<Node> operands);
+    void validate(Node node) const;
+    Matrix<T> compute(const NodeData& node) const;
+    void complete(std::size_t id, std::deque<std::size_t>& ready);
+
+    inline static std::atomic<std::uint64_t> nextId_{ 1 };
+
+    std::uint64_t id_{ nextId_.fetch_add(1, std::memory_order_relaxed) };  // Unique per graph, so foreign handles are rejected.
+    std::vector<NodeData> nodes_;
+    bool executed_{ false };
+};
+
+
+template<typename T>
+typename TaskGraph<T>::Node TaskGraph<T>::input(Matrix<T> matrix) {
+    const Node node{ addNode(Operation::Input, {}) };
+    nodes_[node.id_].value.emplace(std::move(matrix));
+    return node;
+}
+
+template<typename T>
+typename TaskGraph<T>::Node TaskGraph<T>::add(Node lhs, Node rhs) {
+    return addNode(Operation::Add, { lhs, rhs });
+}
+
+template<typename T>
+typename TaskGraph<T>::Node TaskGraph<T>::multiply(Node lhs, Node rhs) {
+    return addNode(Operation::Multiply, { lhs, rhs });
+}
+
+template<typename T>
+typename TaskGraph<T>::Node TaskGraph<T>::transpose(Node operand) {
+    return addNode(Operation::Transpose, { operand });
+}
+
+template<typename T>
+std::future<Matrix<T>> TaskGraph<T>::result(Node node) {
+    if(executed_) {
+        throw std::logic_error("Cannot request a result after the task graph has been run");
+    }
+    validate(node);
+    auto& promise{ nodes_[node.id_].promise };
+    if(promise) {
+        throw std::future_error(std::future_errc::future_already_retrieved);
+    }
+    return promise.emplace().get_future();
+}
+
+template<typename T>
+std::size_t TaskGraph<T>::size() const {
+    return nodes_.size();
+}
+
+template<typename T>
+typename TaskGraph<T>::Node TaskGraph<T>::addNode(Operation operation, std::initializer_list<Node> operands) {
+    if(executed_) {
+        throw std::logic_error("Cannot extend a task graph that has already been run");
+    }
+    for(const Node operand : operands) {
+        validate(operand);
+    }
+
+    const std::size_t id{ nodes_.size() };
+    NodeData& data{ nodes_.emplace_back() };
+    data.operation = operation;
+    for(const Node operand : operands) {
+        data.operands[data.operandCount++] = operand.id_;
+        ++data.pendingOperands;
+        nodes_[operand.id_].dependents.push_back(id);
+        ++nodes_[operand.id_].remainingConsumers;
+    }
+    return Node{ id_, id };
+}
+
+template<typename T>
+void TaskGraph<T>::validate(Node node) const {
+    if(node.graph_ != id_ || node.id_ >= nodes_.size()) {
+        throw std::invalid_argument("Node does not belong to the task graph");
+    }
+}
+
+template<typename T>
+Matrix<T> TaskGraph<T>::compute(const NodeData& node) const {
+    const Matrix<T>& lhs{ *nodes_[node.operands[0]].value };
+    switch(node.operation) {
+        case Operation::Add: return lhs + *nodes_[node.operands[1]].value;
+        case Operation::Multiply: return lhs * *nodes_[node.operands[1]].value;
+        case Operation::Transpose: return lhs.transpose();
+        case Operation::Input: break;
+    }
+    return lhs;  // Unreachable: input nodes are never computed.
+}
+
+// Must be called with the scheduler mutex held.
+template<typename T>
+void TaskGraph<T>::complete(std::size_t id, std::deque<std::size_t>& ready) {
+    NodeData& node{ nodes_[id] };
+
+    if(node.promise) {
+        if(node.error) {
+            node.promise->set_exception(node.error);
+        } else if(node.remainingConsumers == 0) {
+            node.promise->set_value(std::move(*node.value));
+            node.value.reset();
+        } else {
+            node.promise->set_value(*node.value);
+        }
+    }
+    if(node.remainingConsumers == 0) {
+        node.value.reset();
+    }
+
+    // Operands of this node may now be released.
+    for(std::size_t i{}; i < node.operandCount; ++i) {
+        NodeData& operand{ nodes_[node.operands[i]] };
+        if(--operand.remainingConsumers == 0) {
+            operand.value.reset();
+        }
+    }
+
+    for(const std::size_t dependent : node.dependents) {
+        NodeData& next{ nodes_[dependent] };
+        if(node.error && !next.error) {
+            next.error = node.error;
+        }
+        if(--next.pendingOperands == 0) {
+            ready.push_back(dependent);
+        }
+    }
+}
+
+template<typename T>
+void TaskGraph<T>::run(std::size_t threads) {
+    if(executed_) {
+        throw std::logic_error("Task graph has already been run");
+    }
+    executed_ = true;
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::deque<std::size_t> ready;
+    std::size_t unfinished{ nodes_.size() };
+
+    {
+        // Inputs are already computed: propagate their completion first.
+        std::deque<std::size_t> inputs;
+        for(std::size_t id{}; id < nodes_.size(); ++id) {
+            if(nodes_[id].operation == Operation::Input) {
+                inputs.push_back(id);
+            }
+        }
+        for(const std::size_t id : inputs) {
+            complete(id, ready);
+            --unfinished;
+        }
+    }
+
+    const auto worker{ [&] {
+        std::unique_lock lock{ mutex };
+        while(true) {
+            cv.wait(lock, [&] { return !ready.empty() || unfinished == 0; });
+            if(ready.empty()) {
+                return;
+            }
+
+            const std::size_t id{ ready.front() };
+            ready.pop_front();
+            NodeData& node{ nodes_[id] };
+
+            if(!node.error) {
+                // Operands are immutable until this node completes, so no lock is needed.
+                lock.unlock();
+                try {
+                    node.value.emplace(compute(node));
+                } catch(...) {
+                    node.error = std::current_exception();
+                }
+                lock.lock();
+            }
+
+            complete(id, ready);
+            --unfinished;
+            cv.notify_all();
+        }
+    } };
+
+    std::vector<std::thread> pool;
+    const std::size_t count{ threads > 0 ? threads : 1 };
+    for(std::size_t i{ 1 }; i < count; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for(std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+}  // namespace setm
@@ -1,9 +1,15 @@
+#include <cmath>      // std::sqrt.
 #include <cstddef>    // std::size_t.
+#include <cstdint>    // std::uint64_t.
 #include <stdexcept>  // std::runtime_error, std::invalid_argument, std::out_of_range.
+#include <string>     // std::string.
+#include <utility>    // std::move.
 
 #include <gtest/gtest.h>  // Google Test.
 
-#include "matrix.hpp"  // setm::Matrix.
+#include "matrix.hpp"      // setm::Matrix.
+#include "packed.hpp"      // setm::SymmetricMatrix, setm::TriangularMatrix.
+#include "task_graph.hpp"  // setm::TaskGraph.
 
 using namespace setm;
 
@@ -109,6 +115,31 @@ TYPED_TEST_P(MatrixTest, MoveAssignment) {
     EXPECT_EQ(moved.getElement(2, 2), 9);
 }
 
+TYPED_TEST_P(MatrixTest, CopyAndMoveAcrossStorage) {
+    // 3x3 matrices are stored inline, 16x16 ones on the heap.
+    Matrix<TypeParam> small{ this->createSampleMatrix() };
+    Matrix<TypeParam> large{ 16, 16, TypeParam{ 7 } };
+    const Matrix<TypeParam> smallCopy{ small };
+    const Matrix<TypeParam> largeCopy{ large };
+
+    Matrix<TypeParam> target{ large };
+    target = small;
+    EXPECT_EQ(target, smallCopy);
+    target = large;
+    EXPECT_EQ(target, largeCopy);
+
+    Matrix<TypeParam> movedSmall{ std::move(small) };
+    EXPECT_EQ(movedSmall, smallCopy);
+    EXPECT_EQ(small.getRows(), 0);
+
+    target = std::move(movedSmall);
+    EXPECT_EQ(target, smallCopy);
+
+    target = std::move(large);
+    EXPECT_EQ(target, largeCopy);
+    EXPECT_EQ(large.getRows(), 0);
+}
+
 TYPED_TEST_P(MatrixTest, GetSetElement) {
     Matrix<TypeParam> matrix{ 2, 2 };
 
@@ -224,6 +255,109 @@ TYPED_TEST_P(MatrixTest, MultiplicationWithEmptyMatrix) {
     EXPECT_THROW(matrix * emptyMatrix, std::runtime_error);
 }
 
+TYPED_TEST_P(MatrixTest, ElementWise) {
+    const Matrix<TypeParam> matrix{ this->createSampleMatrix() };
+
+    const Matrix<TypeParam> doubled{ matrix.map([](TypeParam value) { return value * 2; }) };
+    EXPECT_EQ(doubled, matrix + matrix);
+
+    const Matrix<TypeParam> hadamard{ matrix.zipWith(matrix, [](TypeParam lhs, TypeParam rhs) { return lhs * rhs; }) };
+    EXPECT_EQ(hadamard.getElement(0, 1), 4);
+    EXPECT_EQ(hadamard.getElement(2, 2), 81);
+
+    EXPECT_THROW(matrix.zipWith(Matrix<TypeParam>{ 2, 2 }, [](TypeParam lhs, TypeParam) { return lhs; }), std::runtime_error);
+}
+
+TYPED_TEST_P(MatrixTest, Reductions) {
+    const Matrix<TypeParam> matrix{ this->createSampleMatrix() };
+
+    EXPECT_EQ(matrix.sum(), 45);
+    EXPECT_EQ(matrix.min(), 1);
+    EXPECT_EQ(matrix.max(), 9);
+    EXPECT_EQ(matrix.trace(), 15);
+    EXPECT_DOUBLE_EQ(matrix.norm(), std::sqrt(285.0));
+    EXPECT_EQ(matrix.reduce(TypeParam{ 1 }, [](TypeParam lhs, TypeParam rhs) { return lhs < rhs ? rhs : lhs; }), 9);
+
+    EXPECT_EQ(Matrix<TypeParam>{}.sum(), TypeParam{});
+    EXPECT_THROW(Matrix<TypeParam>{}.min(), std::runtime_error);
+    EXPECT_THROW(Matrix<TypeParam>(2, 3).trace(), std::runtime_error);
+
+    // Large enough to be reduced in parallel.
+    const Matrix<TypeParam> large{ 512, 1024, TypeParam{ 1 } };
+    EXPECT_EQ(large.sum(), static_cast<TypeParam>(512 * 1024));
+}
+
+TYPED_TEST_P(MatrixTest, PackedSymmetric) {
+    const Matrix<TypeParam> sample{ this->createSampleMatrix() };
+    const Matrix<TypeParam> dense{ sample + sample.transpose() };
+
+    const SymmetricMatrix<TypeParam> symmetric{ dense };
+    EXPECT_EQ(symmetric.getPackedSize(), 6);
+    EXPECT_EQ(symmetric.toMatrix(), dense);
+    EXPECT_EQ(symmetric * sample, dense * sample);
+
+    SymmetricMatrix<TypeParam> modified{ symmetric };
+    modified.setElement(0, 2, 42);
+    EXPECT_EQ(modified.getElement(2, 0), 42);
+    EXPECT_EQ(symmetric.getElement(2, 0), dense.getElement(2, 0));
+
+    EXPECT_THROW(modified.getElement(3, 0), std::out_of_range);
+    EXPECT_THROW(SymmetricMatrix<TypeParam>{ Matrix<TypeParam>(2, 3) }, std::invalid_argument);
+    EXPECT_THROW(symmetric * Matrix<TypeParam>(2, 2), std::runtime_error);
+}
+
+TYPED_TEST_P(MatrixTest, PackedTriangular) {
+    const Matrix<TypeParam> sample{ this->createSampleMatrix() };
+
+    const UpperTriangularMatrix<TypeParam> upper{ sample };
+    const LowerTriangularMatrix<TypeParam> lower{ sample };
+
+    const TypeParam upperData[9] = { 1, 2, 3, 0, 5, 6, 0, 0, 9 };
+    const TypeParam lowerData[9] = { 1, 0, 0, 4, 5, 0, 7, 8, 9 };
+    const Matrix<TypeParam> upperDense{ upperData, 3, 3 };
+    const Matrix<TypeParam> lowerDense{ lowerData, 3, 3 };
+
+    EXPECT_EQ(upper.toMatrix(), upperDense);
+    EXPECT_EQ(lower.toMatrix(), lowerDense);
+    EXPECT_EQ(upper * sample, upperDense * sample);
+    EXPECT_EQ(lower * sample, lowerDense * sample);
+
+    EXPECT_EQ(upper.getElement(2, 0), 0);
+    UpperTriangularMatrix<TypeParam> modified{ 3 };
+    EXPECT_NO_THROW(modified.setElement(0, 2, 1));
+    EXPECT_THROW(modified.setElement(2, 0, 1), std::out_of_range);
+}
+
+TYPED_TEST_P(MatrixTest, DeferredExecution) {
+    const Matrix<TypeParam> sample{ this->createSampleMatrix() };
+
+    TaskGraph<TypeParam> graph;
+    const auto a{ graph.input(sample) };
+    const auto b{ graph.input(sample.transpose()) };
+    // Two independent branches joined by the final addition.
+    const auto product{ graph.multiply(a, b) };
+    const auto sum{ graph.add(a, graph.transpose(b)) };
+    auto productResult{ graph.result(product) };
+    auto totalResult{ graph.result(graph.add(product, sum)) };
+    auto invalidResult{ graph.result(graph.add(a, graph.input(Matrix<TypeParam>{ 2, 2 }))) };
+
+    graph.run(4);
+
+    const Matrix<TypeParam> expectedProduct{ sample * sample.transpose() };
+    EXPECT_EQ(productResult.get(), expectedProduct);
+    EXPECT_EQ(totalResult.get(), expectedProduct + (sample + sample));
+    EXPECT_THROW(invalidResult.get(), std::runtime_error);
+    EXPECT_THROW(graph.run(), std::logic_error);
+    EXPECT_THROW(graph.result(product), std::logic_error);
+
+    // Handles of another graph (or default-constructed ones) are rejected.
+    TaskGraph<TypeParam> other;
+    const auto otherInput{ other.input(sample) };
+    EXPECT_THROW(other.add(otherInput, a), std::invalid_argument);
+    EXPECT_THROW(other.transpose(typename TaskGraph<TypeParam>::Node{}), std::invalid_argument);
+    EXPECT_NO_THROW(other.transpose(otherInput));
+}
+
 
 REGISTER_TYPED_TEST_SUITE_P(MatrixTest,
                             DefaultConstructor,
@@ -232,6 +366,7 @@ REGISTER_TYPED_TEST_SUITE_P(MatrixTest,
                             MoveConstructor,
                             CopyAssignment,
                             MoveAssignment,
+                            CopyAndMoveAcrossStorage,
                             GetSetElement,
                             Transpose,
                             Addition,
@@ -241,8 +376,54 @@ REGISTER_TYPED_TEST_SUITE_P(MatrixTest,
                             OutOfBoundsAccess,
                             EqualityOperator,
                             InequalityOperator,
-                            MultiplicationWithEmptyMatrix);
+                            MultiplicationWithEmptyMatrix,
+                            ElementWise,
+                            Reductions,
+                            PackedSymmetric,
+                            PackedTriangular,
+                            DeferredExecution);
 
 // Register types for testing (e.g., int, double, float).
 using TestTypes = ::testing::Types<int, double, float>;
 INSTANTIATE_TYPED_TEST_SUITE_P(MatrixTests, MatrixTest, TestTypes);
+
+TEST(MatrixPow, Fibonacci) {
+    const std::uint64_t fibonacciData[4] = { 1, 1, 1, 0 };
+    const Matrix<std::uint64_t> fibonacci{ fibonacciData, 2, 2 };
+
+    // [[1, 1], [1, 0]]^n = [[F(n + 1), F(n)], [F(n), F(n - 1)]].
+    EXPECT_EQ(fibonacci.pow(0).getElement(0, 0), 1);
+    EXPECT_EQ(fibonacci.pow(0).getElement(0, 1), 0);
+    EXPECT_EQ(fibonacci.pow(1), fibonacci);
+    EXPECT_EQ(pow(fibonacci, 90).getElement(0, 1), 2'880'067'194'370'816'120ULL);
+    EXPECT_EQ(fibonacci.pow(10, 7).getElement(0, 1), 55 % 7);
+
+    EXPECT_EQ(pow(fibonacci, 1'000'000'000'000'000'000ULL, std::uint64_t{ 1'000'000'007 }).getElement(0, 1), 209'783'453);
+    EXPECT_EQ(pow(fibonacci, 1'000'000'000'000'000'000ULL, std::uint64_t{ 998'244'353 }).getElement(0, 1), 23'849'548);
+}
+
+TEST(MatrixPow, Invalid) {
+    const Matrix<int> matrix{ 2, 3, 1 };
+    const Matrix<int> negative{ 2, 2, -1 };
+
+    EXPECT_THROW(matrix.pow(2), std::runtime_error);
+    EXPECT_THROW(negative.pow(2, 0), std::invalid_argument);
+    // [[-1, -1], [-1, -1]]^2 = [[2, 2], [2, 2]].
+    EXPECT_EQ(negative.pow(2, 5), Matrix<int>(2, 2, 2));
+}
+
+TEST(MatrixStorage, NonTrivialElements) {
+    // Only trivial element types get the inline buffer.
+    static_assert(sizeof(Matrix<std::string>) < sizeof(Matrix<double>));
+
+    Matrix<std::string> small{ 2, 2, "a" };
+    small.setElement(1, 1, "b");
+    Matrix<std::string> copy{ small };
+    const Matrix<std::string> moved{ std::move(small) };
+    EXPECT_EQ(moved.getElement(1, 1), "b");
+    EXPECT_EQ(small.getRows(), 0);
+
+    copy = Matrix<std::string>{ 1, 3, "c" };
+    EXPECT_EQ(copy.getCols(), 3);
+    EXPECT_EQ(copy.getElement(0, 2), "c");
+}
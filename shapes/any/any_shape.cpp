@@ -0,0 +1,52 @@
+#include "any/any_shape.hpp"
+
+#include <compare>      // std::partial_ordering.
+#include <string_view>  // std::string_view.
+#include <variant>      // std::variant, std::visit.
+
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "circle/circle.hpp"              // setm::Circle.
+#include "point/point.hpp"                // setm::Point.
+#include "rectangle/rectangle.hpp"        // setm::Rectangle.
+
+namespace setm {
+
+AnyShape::AnyShape(const Circle& circle)
+    : shape_{ circle } {}
+
+AnyShape::AnyShape(const Rectangle& rectangle)
+    : shape_{ rectangle } {}
+
+double AnyShape::getArea() const {
+    return std::visit([](const auto& shape) { return shape.getArea(); }, shape_);
+}
+
+void AnyShape::scale(double factor) {
+    std::visit([factor](auto& shape) { shape.scale(factor); }, shape_);
+}
+
+Point AnyShape::getCenter() const {
+    return std::visit([](const auto& shape) { return shape.getCenter(); }, shape_);
+}
+
+BoundingBox AnyShape::getBoundingBox() const {
+    return std::visit([](const auto& shape) { return shape.getBoundingBox(); }, shape_);
+}
+
+bool AnyShape::contains(const Point& point) const {
+    return std::visit([&point](const auto& shape) { return shape.contains(point); }, shape_);
+}
+
+std::string_view AnyShape::getName() const {
+    return std::visit([](const auto& shape) { return shape.getName(); }, shape_);
+}
+
+const std::variant<Circle, Rectangle>& AnyShape::asVariant() const {
+    return shape_;
+}
+
+std::partial_ordering AnyShape::operator<=>(const AnyShape& other) const {
+    return getArea() <=> other.getArea();
+}
+
+}  // namespace setm
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <compare>      // std::partial_ordering.
+#include <string_view>  // std::string_view.
+#include <variant>      // std::variant.
+
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "circle/circle.hpp"              // setm::Circle.
+#include "point/point.hpp"                // setm::Point.
+#include "rectangle/rectangle.hpp"        // setm::Rectangle.
+
+namespace setm {
+
+/**
+ * @brief Value type holding any concrete shape.
+ *
+ * AnyShape stores the shape itself (not a pointer), so a std::vector<AnyShape> keeps all
+ * shapes contiguous without a heap allocation per shape. Operations are dispatched with
+ * std::visit to the final Circle and Rectangle classes, so no virtual call is needed.
+ *
+ * Like Shape, AnyShape objects are compared based on their areas.
+ */
+class AnyShape {
+public:
+    /**
+     * @brief Constructs an AnyShape holding a copy of the given shape.
+     * @param circle The circle to hold.
+     */
+    AnyShape(const Circle& circle);
+
+    /**
+     * @brief Constructs an AnyShape holding a copy of the given shape.
+     * @param rectangle The rectangle to hold.
+     */
+    AnyShape(const Rectangle& rectangle);
+
+    /**
+     * @brief Calculates and returns the area of the held shape.
+     * @return The area of the shape.
+     */
+    double getArea() const;
+
+    /**
+     * @brief Scales the held shape isotropically relative to its center by the specified factor.
+     * @param factor The scaling factor.
+     * @throws std::invalid_argument if the provided factor is not valid (is equal to 0).
+     */
+    void scale(double factor);
+
+    /**
+     * @brief Retrieves the center coordinates of the held shape.
+     * @return The center coordinates of the shape.
+     */
+    Point getCenter() const;
+
+    /**
+     * @brief Retrieves the axis-aligned bounding box of the held shape.
+     * @return The smallest axis-aligned box that contains the shape.
+     */
+    BoundingBox getBoundingBox() const;
+
+    /**
+     * @brief Checks if a point lies inside the held shape.
+     * @param point The point to check.
+     * @return True if the point is inside the shape or on its border.
+     */
+    bool contains(const Point& point) const;
+
+    /**
+     * @brief Gets the name of the held shape.
+     * @return The name of the shape.
+     */
+    std::string_view getName() const;
+
+    /**
+     * @brief Retrieves the held shape, for use with std::visit or std::get_if.
+     * @return The variant holding the shape.
+     */
+    const std::variant<Circle, Rectangle>& asVariant() const;
+
+    /**
+     * @brief Spaceship operator to compare shapes based on their areas.
+     * @param other The shape to compare to.
+     * @return A three-way comparison result.
+     */
+    std::partial_ordering operator<=>(const AnyShape& other) const;
+
+private:
+    std::variant<Circle, Rectangle> shape_;  // The held shape.
+};
+
+}  // namespace setm
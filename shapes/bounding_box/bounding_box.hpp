@@ -0,0 +1,67 @@
+#pragma once
+
+#include <algorithm>  // std::max, std::min.
+
+#include "point/point.hpp"  // setm::Point.
+
+namespace setm {
+
+/**
+ * @brief Represents an axis-aligned bounding box in a two-dimensional space.
+ *
+ * The BoundingBox struct stores the minimum (bottom-left) and maximum (top-right) corners
+ * of the box. Boxes are closed: points on the border are inside the box.
+ */
+struct BoundingBox {
+    Point min;  // The bottom-left corner of the box.
+    Point max;  // The top-right corner of the box.
+
+    /**
+     * @brief Checks if the box shares at least one point with another box.
+     * @param other The box to check against.
+     * @return True if the boxes intersect.
+     */
+    constexpr bool intersects(const BoundingBox& other) const {
+        return min.x <= other.max.x && other.min.x <= max.x && min.y <= other.max.y && other.min.y <= max.y;
+    }
+
+    /**
+     * @brief Checks if a point lies inside the box.
+     * @param point The point to check.
+     * @return True if the point is inside the box or on its border.
+     */
+    constexpr bool contains(const Point& point) const {
+        return min.x <= point.x && point.x <= max.x && min.y <= point.y && point.y <= max.y;
+    }
+
+    /**
+     * @brief Calculates the squared distance from a point to the box (0 for points inside).
+     * @param point The point.
+     * @return The squared distance.
+     */
+    constexpr double squaredDistance(const Point& point) const {
+        const double dx{ std::max({ min.x - point.x, 0.0, point.x - max.x }) };
+        const double dy{ std::max({ min.y - point.y, 0.0, point.y - max.y }) };
+        return dx * dx + dy * dy;
+    }
+
+    /**
+     * @brief Calculates the area of the box.
+     * @return The area of the box.
+     */
+    constexpr double getArea() const {
+        return (max.x - min.x) * (max.y - min.y);
+    }
+
+    /**
+     * @brief Calculates the smallest box that contains both boxes.
+     * @param other The box to merge with.
+     * @return The merged box.
+     */
+    constexpr BoundingBox merge(const BoundingBox& other) const {
+        return { { std::min(min.x, other.min.x), std::min(min.y, other.min.y) },
+                 { std::max(max.x, other.max.x), std::max(max.y, other.max.y) } };
+    }
+};
+
+}  // namespace setm
@@ -1,5 +1,7 @@
 #include "circle/circle.hpp"
 
+#include <algorithm>    // std::max.
+#include <cmath>        // std::abs, std::hypot.
 #include <numbers>      // std::numbers::pi_v.
 #include <stdexcept>    // std::invalid_argument.
 #include <string_view>  // std::string_view.
@@ -29,6 +31,27 @@ Point Circle::getCenter() const {
     return center_;
 }
 
+double Circle::getRadius() const {
+    return radius_;
+}
+
+BoundingBox Circle::getBoundingBox() const {
+    // The radius is negative after scaling by a negative factor.
+    const double radius{ std::abs(radius_) };
+    return { { center_.x - radius, center_.y - radius }, { center_.x + radius, center_.y + radius } };
+}
+
+bool Circle::contains(const Point& point) const {
+    const double dx{ point.x - center_.x };
+    const double dy{ point.y - center_.y };
+    return dx * dx + dy * dy <= radius_ * radius_;
+}
+
+double Circle::squaredDistance(const Point& point) const {
+    const double distance{ std::max(std::hypot(point.x - center_.x, point.y - center_.y) - std::abs(radius_), 0.0) };
+    return distance * distance;
+}
+
 std::string_view Circle::getName() const {
     return "CIRCLE";
 }
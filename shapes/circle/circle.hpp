@@ -2,8 +2,9 @@
 
 #include <string_view>  // std::string_view.
 
-#include "point/point.hpp"  // setm::Point.
-#include "shape/shape.hpp"  // setm::Shape.
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "point/point.hpp"                // setm::Point.
+#include "shape/shape.hpp"                // setm::Shape.
 
 namespace setm {
 
@@ -13,7 +14,7 @@ namespace setm {
  * The Circle class is a concrete implementation of the Shape interface,
  * representing a circle defined by its center and radius.
  */
-class Circle : public Shape {
+class Circle final : public Shape {
 public:
     /**
      * @brief Constructs a circle with the specified center and radius.
@@ -43,6 +44,32 @@ public:
      */
     Point getCenter() const override;
 
+    /**
+     * @brief Retrieves the axis-aligned bounding box of the circle.
+     * @return The smallest axis-aligned box that contains the circle.
+     */
+    BoundingBox getBoundingBox() const override;
+
+    /**
+     * @brief Checks if a point lies inside the circle.
+     * @param point The point to check.
+     * @return True if the point is inside the circle or on its border.
+     */
+    bool contains(const Point& point) const override;
+
+    /**
+     * @brief Calculates the squared distance from a point to the circle.
+     * @param point The point.
+     * @return The squared distance (0 for points inside the circle or on its border).
+     */
+    double squaredDistance(const Point& point) const override;
+
+    /**
+     * @brief Retrieves the radius of the circle.
+     * @return The radius of the circle.
+     */
+    double getRadius() const;
+
     /**
      * @brief Gets the name of the shape (in this case, "CIRCLE").
      * @return The name of the shape as a C-style string.
@@ -0,0 +1,237 @@
+#include "collision/collision.hpp"
+
+#include <algorithm>      // std::clamp, std::max, std::min, std::sort.
+#include <cmath>          // std::abs, std::floor.
+#include <cstddef>        // std::size_t.
+#include <cstdint>        // std::int32_t, std::int64_t, std::uint32_t, std::uint64_t.
+#include <limits>         // std::numeric_limits.
+#include <stdexcept>      // std::invalid_argument.
+#include <thread>         // std::thread.
+#include <unordered_map>  // std::unordered_map.
+#include <vector>         // std::vector.
+
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "circle/circle.hpp"              // setm::Circle.
+#include "rectangle/rectangle.hpp"        // setm::Rectangle.
+#include "shape/shape.hpp"                // setm::Shape.
+
+namespace setm {
+
+namespace {
+
+std::uint64_t cellKey(std::int32_t x, std::int32_t y) {
+    return static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32 | static_cast<std::uint32_t>(y);
+}
+
+std::int32_t cellCoordinate(double value, double cellSize) {
+    constexpr double limit{ std::numeric_limits<std::int32_t>::max() };
+    return static_cast<std::int32_t>(std::clamp(std::floor(value / cellSize), -limit, limit));
+}
+
+}  // Anonymous namespace.
+
+bool overlaps(const Circle& lhs, const Circle& rhs) {
+    const double dx{ lhs.getCenter().x - rhs.getCenter().x };
+    const double dy{ lhs.getCenter().y - rhs.getCenter().y };
+    const double radii{ std::abs(lhs.getRadius()) + std::abs(rhs.getRadius()) };
+    return dx * dx + dy * dy <= radii * radii;
+}
+
+bool overlaps(const Rectangle& lhs, const Rectangle& rhs) {
+    return lhs.getBoundingBox().intersects(rhs.getBoundingBox());
+}
+
+bool overlaps(const Circle& lhs, const Rectangle& rhs) {
+    return rhs.getBoundingBox().squaredDistance(lhs.getCenter()) <= lhs.getRadius() * lhs.getRadius();
+}
+
+bool overlaps(const Rectangle& lhs, const Circle& rhs) {
+    return overlaps(rhs, lhs);
+}
+
+bool overlaps(const Shape& lhs, const Shape& rhs) {
+    const auto* const lhsCircle{ dynamic_cast<const Circle*>(&lhs) };
+    const auto* const rhsCircle{ dynamic_cast<const Circle*>(&rhs) };
+    const auto* const lhsRectangle{ dynamic_cast<const Rectangle*>(&lhs) };
+    const auto* const rhsRectangle{ dynamic_cast<const Rectangle*>(&rhs) };
+
+    if(lhsCircle && rhsCircle) {
+        return overlaps(*lhsCircle, *rhsCircle);
+    }
+    if(lhsCircle && rhsRectangle) {
+        return overlaps(*lhsCircle, *rhsRectangle);
+    }
+    if(lhsRectangle && rhsCircle) {
+        return overlaps(*lhsRectangle, *rhsCircle);
+    }
+    if(lhsRectangle && rhsRectangle) {
+        return overlaps(*lhsRectangle, *rhsRectangle);
+    }
+    throw std::invalid_argument("Unsupported shape type");
+}
+
+CollisionGrid::CollisionGrid(double cellSize)
+    : cellSize_{ cellSize } {
+    if(!(cellSize_ > 0)) {
+        throw std::invalid_argument("Invalid cell size");
+    }
+}
+
+void CollisionGrid::insert(const Shape* shape) {
+    const auto [entry, inserted]{ entries_.try_emplace(shape, makeEntry(shape)) };
+    if(!inserted) {
+        throw std::invalid_argument("Shape is already in the grid");
+    }
+    addToCells(shape, entry->second);
+}
+
+bool CollisionGrid::remove(const Shape* shape) {
+    const auto entry{ entries_.find(shape) };
+    if(entry == entries_.end()) {
+        return false;
+    }
+    removeFromCells(shape, entry->second);
+    entries_.erase(entry);
+    return true;
+}
+
+void CollisionGrid::update(const Shape* shape) {
+    const auto entry{ entries_.find(shape) };
+    if(entry == entries_.end()) {
+        throw std::invalid_argument("Shape is not in the grid");
+    }
+
+    const Entry updated{ makeEntry(shape) };
+    const bool moved{ updated.oversized != entry->second.oversized || (!updated.oversized && updated.cells != entry->second.cells) };
+    if(moved) {
+        removeFromCells(shape, entry->second);
+        addToCells(shape, updated);
+    }
+    entry->second = updated;
+}
+
+void CollisionGrid::updateAll() {
+    for(const auto& [shape, entry] : entries_) {
+        update(shape);
+    }
+}
+
+std::vector<CollisionGrid::Pair> CollisionGrid::findPairs(std::size_t threads) const {
+    std::vector<std::pair<std::int32_t, std::int32_t>> coordinates;
+    std::vector<const std::vector<const Shape*>*> cells;
+    for(const auto& [key, shapes] : cells_) {
+        if(shapes.size() > 1) {
+            coordinates.emplace_back(static_cast<std::int32_t>(key >> 32), static_cast<std::int32_t>(key & 0xFFFFFFFF));
+            cells.push_back(&shapes);
+        }
+    }
+
+    // Each thread scans a contiguous range of work items (the cells, then the oversized shapes)
+    // into its own list of pairs.
+    const std::size_t items{ cells.size() + oversized_.size() };
+    const std::size_t count{ std::max<std::size_t>(1, std::min(threads, items)) };
+    std::vector<std::vector<Pair>> partial(count);
+    const auto scan{ [&](std::size_t part) {
+        const std::size_t begin{ items * part / count };
+        const std::size_t end{ items * (part + 1) / count };
+        for(std::size_t item{ std::max(begin, cells.size()) }; item < end; ++item) {
+            const Shape* const shape{ oversized_[item - cells.size()] };
+            const Entry& first{ entries_.at(shape) };
+            for(const auto& [other, second] : entries_) {
+                // Pairs of oversized shapes are tested by the shape with the lower address only.
+                if(other == shape || (second.oversized && other < shape)) {
+                    continue;
+                }
+                if(first.box.intersects(second.box) && overlaps(*shape, *other)) {
+                    partial[part].push_back(shape < other ? Pair{ shape, other } : Pair{ other, shape });
+                }
+            }
+        }
+        for(std::size_t cell{ begin }; cell < std::min(end, cells.size()); ++cell) {
+            const std::vector<const Shape*>& shapes{ *cells[cell] };
+            for(std::size_t i{}; i < shapes.size(); ++i) {
+                const Entry& first{ entries_.at(shapes[i]) };
+                for(std::size_t j{ i + 1 }; j < shapes.size(); ++j) {
+                    const Entry& second{ entries_.at(shapes[j]) };
+
+                    // Test the pair only in the first cell both shapes cover.
+                    const std::int32_t sharedX{ std::max(first.cells.minX, second.cells.minX) };
+                    const std::int32_t sharedY{ std::max(first.cells.minY, second.cells.minY) };
+                    if(sharedX != coordinates[cell].first || sharedY != coordinates[cell].second) {
+                        continue;
+                    }
+                    if(first.box.intersects(second.box) && overlaps(*shapes[i], *shapes[j])) {
+                        partial[part].push_back(shapes[i] < shapes[j] ? Pair{ shapes[i], shapes[j] } : Pair{ shapes[j], shapes[i] });
+                    }
+                }
+            }
+        }
+    } };
+
+    std::vector<std::thread> pool;
+    for(std::size_t part{ 1 }; part < count; ++part) {
+        pool.emplace_back(scan, part);
+    }
+    scan(0);
+    for(std::thread& thread : pool) {
+        thread.join();
+    }
+
+    std::vector<Pair> pairs;
+    for(const std::vector<Pair>& part : partial) {
+        pairs.insert(pairs.end(), part.begin(), part.end());
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+std::size_t CollisionGrid::size() const {
+    return entries_.size();
+}
+
+CollisionGrid::Entry CollisionGrid::makeEntry(const Shape* shape) const {
+    const BoundingBox box{ shape->getBoundingBox() };
+    const CellRange cells{ cellCoordinate(box.min.x, cellSize_), cellCoordinate(box.min.y, cellSize_),
+                           cellCoordinate(box.max.x, cellSize_), cellCoordinate(box.max.y, cellSize_) };
+
+    // Widths are checked first so the product cannot overflow.
+    const std::int64_t width{ std::int64_t{ cells.maxX } - cells.minX + 1 };
+    const std::int64_t height{ std::int64_t{ cells.maxY } - cells.minY + 1 };
+    const bool oversized{ width > MAX_CELLS_PER_SHAPE || height > MAX_CELLS_PER_SHAPE || width * height > MAX_CELLS_PER_SHAPE };
+    return { box, cells, oversized };
+}
+
+void CollisionGrid::addToCells(const Shape* shape, const Entry& entry) {
+    if(entry.oversized) {
+        oversized_.push_back(shape);
+        return;
+    }
+
+    const CellRange& cells{ entry.cells };
+    for(std::int64_t x{ cells.minX }; x <= cells.maxX; ++x) {
+        for(std::int64_t y{ cells.minY }; y <= cells.maxY; ++y) {
+            cells_[cellKey(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y))].push_back(shape);
+        }
+    }
+}
+
+void CollisionGrid::removeFromCells(const Shape* shape, const Entry& entry) {
+    if(entry.oversized) {
+        oversized_.erase(std::find(oversized_.begin(), oversized_.end(), shape));
+        return;
+    }
+
+    const CellRange& cells{ entry.cells };
+    for(std::int64_t x{ cells.minX }; x <= cells.maxX; ++x) {
+        for(std::int64_t y{ cells.minY }; y <= cells.maxY; ++y) {
+            const auto cell{ cells_.find(cellKey(static_cast<std::int32_t>(x), static_cast<std::int32_t>(y))) };
+            std::vector<const Shape*>& shapes{ cell->second };
+            shapes.erase(std::find(shapes.begin(), shapes.end(), shape));
+            if(shapes.empty()) {
+                cells_.erase(cell);
+            }
+        }
+    }
+}
+
+}  // namespace setm
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>        // std::size_t.
+#include <cstdint>        // std::int32_t, std::uint64_t.
+#include <thread>         // std::thread.
+#include <unordered_map>  // std::unordered_map.
+#include <utility>        // std::pair.
+#include <vector>         // std::vector.
+
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "circle/circle.hpp"              // setm::Circle.
+#include "rectangle/rectangle.hpp"        // setm::Rectangle.
+#include "shape/shape.hpp"                // setm::Shape.
+
+namespace setm {
+
+/**
+ * @brief Exact overlap tests between two shapes (shapes touching on their border overlap).
+ */
+bool overlaps(const Circle& lhs, const Circle& rhs);
+bool overlaps(const Rectangle& lhs, const Rectangle& rhs);
+bool overlaps(const Circle& lhs, const Rectangle& rhs);
+bool overlaps(const Rectangle& lhs, const Circle& rhs);
+
+/**
+ * @brief Exact overlap test between two shapes of any supported type.
+ * @throws std::invalid_argument if a shape is neither a Circle nor a Rectangle.
+ */
+bool overlaps(const Shape& lhs, const Shape& rhs);
+
+/**
+ * @brief Broad-phase collision detection with a uniform grid.
+ *
+ * Every shape is registered in the grid cells its bounding box covers, so only shapes that
+ * share a cell are tested against each other. Shapes keep their cells between frames:
+ * after a shape has moved or been resized, update() moves it only if it covers different cells.
+ *
+ * Shapes covering more than MAX_CELLS_PER_SHAPE cells are not registered in cells; they are
+ * kept in a separate list and tested against every other shape instead.
+ *
+ * The grid does not own the shapes.
+ */
+class CollisionGrid {
+public:
+    using Pair = std::pair<const Shape*, const Shape*>;
+
+    static constexpr std::int64_t MAX_CELLS_PER_SHAPE{ 64 };
+
+    /**
+     * @brief Constructs an empty grid.
+     * @param cellSize The side of a cell (about the size of a typical shape works well).
+     * @throws std::invalid_argument if the cell size is not greater than 0.
+     */
+    explicit CollisionGrid(double cellSize);
+
+    /**
+     * @brief Adds a shape to the grid.
+     * @param shape The shape to add.
+     * @throws std::invalid_argument if the shape is already in the grid.
+     */
+    void insert(const Shape* shape);
+
+    /**
+     * @brief Removes a shape from the grid.
+     * @param shape The shape to remove.
+     * @return True if the shape was in the grid.
+     */
+    bool remove(const Shape* shape);
+
+    /**
+     * @brief Refreshes a shape after it has moved or been resized.
+     * @param shape The shape to refresh.
+     * @throws std::invalid_argument if the shape is not in the grid.
+     */
+    void update(const Shape* shape);
+
+    /**
+     * @brief Refreshes every shape of the grid (for example once per frame).
+     */
+    void updateAll();
+
+    /**
+     * @brief Finds every pair of overlapping shapes.
+     *
+     * The cells are split between threads; each pair is tested once, in the first cell both shapes share.
+     *
+     * @param threads The number of threads to use (at least one is used).
+     * @return The pairs (the shape with the lower address first), sorted.
+     */
+    std::vector<Pair> findPairs(std::size_t threads = std::thread::hardware_concurrency()) const;
+
+    /**
+     * @brief Gets the number of shapes in the grid.
+     * @return The number of shapes.
+     */
+    std::size_t size() const;
+
+private:
+    // Range of cells covered by a bounding box (inclusive).
+    struct CellRange {
+        std::int32_t minX;
+        std::int32_t minY;
+        std::int32_t maxX;
+        std::int32_t maxY;
+
+        bool operator==(const CellRange& other) const = default;
+    };
+
+    struct Entry {
+        BoundingBox box;
+        CellRange cells;
+        bool oversized;  // Kept in oversized_ instead of the cells.
+    };
+
+    Entry makeEntry(const Shape* shape) const;
+    void addToCells(const Shape* shape, const Entry& entry);
+    void removeFromCells(const Shape* shape, const Entry& entry);
+
+    double cellSize_;
+    std::unordered_map<const Shape*, Entry> entries_;
+    std::unordered_map<std::uint64_t, std::vector<const Shape*>> cells_;
+    std::vector<const Shape*> oversized_;  // Shapes covering too many cells.
+};
+
+}  // namespace setm
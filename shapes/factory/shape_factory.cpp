@@ -0,0 +1,98 @@
+#include "factory/shape_factory.hpp"
+
+#include <atomic>           // std::atomic.
+#include <cstddef>          // std::size_t.
+#include <cstdint>          // std::uint64_t.
+#include <memory>           // std::construct_at, std::make_unique.
+#include <memory_resource>  // std::pmr::monotonic_buffer_resource, std::pmr::polymorphic_allocator.
+#include <mutex>            // std::lock_guard, std::mutex.
+#include <stdexcept>        // std::logic_error.
+#include <thread>           // std::this_thread::get_id.
+#include <utility>          // std::forward.
+
+#include "circle/circle.hpp"        // setm::Circle.
+#include "point/point.hpp"          // setm::Point.
+#include "rectangle/rectangle.hpp"  // setm::Rectangle.
+#include "shape/shape.hpp"          // setm::Shape.
+
+namespace setm {
+
+namespace {
+
+// Shapes per arena block at first; monotonic resources grow the following blocks geometrically.
+constexpr std::size_t INITIAL_SHAPES{ 256 };
+
+std::atomic<std::uint64_t> nextFactoryId{ 1 };
+
+// Allocates a T in the given resource and constructs it; the memory stays in the arena if the constructor throws.
+template<typename T, typename... Args>
+T* createIn(std::pmr::memory_resource& resource, Args&&... args) {
+    std::pmr::polymorphic_allocator<T> allocator{ &resource };
+    return std::construct_at(allocator.allocate(1), std::forward<Args>(args)...);
+}
+
+}  // Anonymous namespace.
+
+struct ShapeFactory::Arena {
+    std::pmr::monotonic_buffer_resource circles{ INITIAL_SHAPES * sizeof(Circle) };
+    std::pmr::monotonic_buffer_resource rectangles{ INITIAL_SHAPES * sizeof(Rectangle) };
+};
+
+void ShapeFactory::Deleter::operator()(Shape* shape) const noexcept {
+    shape->~Shape();
+    live->fetch_sub(1, std::memory_order_release);
+}
+
+ShapeFactory::ShapeFactory()
+    : id_{ nextFactoryId.fetch_add(1, std::memory_order_relaxed) } {}
+
+ShapeFactory::~ShapeFactory() = default;
+
+ShapeFactory::Handle<Circle> ShapeFactory::makeCircle(const Point& center, double radius) {
+    Circle* const circle{ createIn<Circle>(arenaOfThisThread().circles, center, radius) };
+    live_.fetch_add(1, std::memory_order_relaxed);
+    return Handle<Circle>{ circle, Deleter{ &live_ } };
+}
+
+ShapeFactory::Handle<Rectangle> ShapeFactory::makeRectangle(const Point& bottomLeft, const Point& topRight) {
+    Rectangle* const rectangle{ createIn<Rectangle>(arenaOfThisThread().rectangles, bottomLeft, topRight) };
+    live_.fetch_add(1, std::memory_order_relaxed);
+    return Handle<Rectangle>{ rectangle, Deleter{ &live_ } };
+}
+
+void ShapeFactory::reset() {
+    if(live_.load(std::memory_order_acquire) != 0) {
+        throw std::logic_error("Cannot reset a factory with live shapes");
+    }
+
+    // The arenas themselves stay, so the threads' cached pointers remain valid.
+    const std::lock_guard<std::mutex> lock{ mutex_ };
+    for(const auto& [thread, arena] : arenas_) {
+        arena->circles.release();
+        arena->rectangles.release();
+    }
+}
+
+std::size_t ShapeFactory::liveCount() const {
+    return live_.load(std::memory_order_relaxed);
+}
+
+ShapeFactory::Arena& ShapeFactory::arenaOfThisThread() {
+    // Each thread remembers the arena it used last, so repeated creation takes no lock.
+    thread_local std::uint64_t cachedFactory{};
+    thread_local Arena* cachedArena{};
+    if(cachedFactory == id_) {
+        return *cachedArena;
+    }
+
+    const std::lock_guard<std::mutex> lock{ mutex_ };
+    std::unique_ptr<Arena>& arena{ arenas_[std::this_thread::get_id()] };
+    if(!arena) {
+        arena = std::make_unique<Arena>();
+    }
+    cachedFactory = id_;
+    cachedArena = arena.get();
+    return *arena;
+}
+
+}  // namespace setm
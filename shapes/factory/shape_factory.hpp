@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>         // std::atomic.
+#include <cstddef>        // std::size_t.
+#include <cstdint>        // std::uint64_t.
+#include <memory>         // std::unique_ptr.
+#include <mutex>          // std::mutex.
+#include <thread>         // std::thread::id.
+#include <unordered_map>  // std::unordered_map.
+
+#include "circle/circle.hpp"        // setm::Circle.
+#include "point/point.hpp"          // setm::Point.
+#include "rectangle/rectangle.hpp"  // setm::Rectangle.
+#include "shape/shape.hpp"          // setm::Shape.
+
+namespace setm {
+
+/**
+ * @brief Creates shapes in arenas instead of with one heap allocation each.
+ *
+ * Every thread that creates shapes gets its own arenas (std::pmr::monotonic_buffer_resource),
+ * one per shape type, so shapes of a type made by a thread lie next to each other and
+ * creation needs no lock once the thread has its arenas.
+ *
+ * Shapes are returned as owning handles. Destroying a handle runs the shape's destructor but
+ * does not free its memory; all the memory is released at once by reset() (for example at the
+ * end of a frame) or when the factory is destroyed. Handles may be destroyed from any thread.
+ *
+ * The factory must outlive every handle it returned.
+ */
+class ShapeFactory {
+public:
+    /**
+     * @brief Destroys a shape without freeing its memory.
+     */
+    struct Deleter {
+        std::atomic<std::size_t>* live{};  // Live shape count of the owning factory.
+
+        void operator()(Shape* shape) const noexcept;
+    };
+
+    template<typename T>
+    using Handle = std::unique_ptr<T, Deleter>;
+
+    ShapeFactory();
+    ~ShapeFactory();
+
+    ShapeFactory(const ShapeFactory&) = delete;
+    ShapeFactory& operator=(const ShapeFactory&) = delete;
+
+    /**
+     * @brief Creates a circle in the calling thread's circle arena.
+     * @return Handle owning the new circle.
+     * @throws std::invalid_argument if the shape is not valid (as in the Circle constructor).
+     */
+    Handle<Circle> makeCircle(const Point& center, double radius);
+
+    /**
+     * @brief Creates a rectangle in the calling thread's rectangle arena.
+     * @return Handle owning the new rectangle.
+     * @throws std::invalid_argument if the shape is not valid (as in the Rectangle constructor).
+     */
+    Handle<Rectangle> makeRectangle(const Point& bottomLeft, const Point& topRight);
+
+    /**
+     * @brief Releases the memory of every arena at once.
+     *
+     * Must not run while another thread creates shapes with this factory.
+     *
+     * @throws std::logic_error if some handles are still alive.
+     */
+    void reset();
+
+    /**
+     * @brief Gets the number of shapes whose handles are still alive.
+     * @return The number of live shapes.
+     */
+    std::size_t liveCount() const;
+
+private:
+    struct Arena;  // Per-thread, per-type memory resources.
+
+    Arena& arenaOfThisThread();
+
+    const std::uint64_t id_;  // Unique for the program's lifetime, so thread caches never mistake factories.
+    std::atomic<std::size_t> live_{};
+    std::mutex mutex_;  // Guards arenas_.
+    std::unordered_map<std::thread::id, std::unique_ptr<Arena>> arenas_;
+};
+
+}  // namespace setm
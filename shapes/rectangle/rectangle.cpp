@@ -1,10 +1,12 @@
 #include "rectangle/rectangle.hpp"
 
+#include <algorithm>    // std::max, std::min.
 #include <stdexcept>    // std::invalid_argument.
 #include <string_view>  // std::string_view.
 
-#include "point/point.hpp"  // setm::Point.
-#include "shape/shape.hpp"  // setm::Shape.
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "point/point.hpp"                // setm::Point.
+#include "shape/shape.hpp"                // setm::Shape.
 
 namespace setm {
 
@@ -38,6 +40,28 @@ Point Rectangle::getCenter() const {
     return { (bottomLeft_.x + topRight_.x) * 0.5, (bottomLeft_.y + topRight_.y) * 0.5 };
 }
 
+Point Rectangle::getBottomLeft() const {
+    return bottomLeft_;
+}
+
+Point Rectangle::getTopRight() const {
+    return topRight_;
+}
+
+BoundingBox Rectangle::getBoundingBox() const {
+    // The corners swap places after scaling by a negative factor.
+    return { { std::min(bottomLeft_.x, topRight_.x), std::min(bottomLeft_.y, topRight_.y) },
+             { std::max(bottomLeft_.x, topRight_.x), std::max(bottomLeft_.y, topRight_.y) } };
+}
+
+bool Rectangle::contains(const Point& point) const {
+    return getBoundingBox().contains(point);
+}
+
+double Rectangle::squaredDistance(const Point& point) const {
+    return getBoundingBox().squaredDistance(point);
+}
+
 std::string_view Rectangle::getName() const {
     return "RECTANGLE";
 }
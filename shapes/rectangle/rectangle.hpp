@@ -2,8 +2,9 @@
 
 #include <string_view>  // std::string_view.
 
-#include "point/point.hpp"  // setm::Point.
-#include "shape/shape.hpp"  // setm::Shape.
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "point/point.hpp"                // setm::Point.
+#include "shape/shape.hpp"                // setm::Shape.
 
 namespace setm {
 
@@ -13,7 +14,7 @@ namespace setm {
  * The Rectangle class is a concrete implementation of the Shape interface,
  * representing a rectangle defined by its bottom-left and top-right coordinates.
  */
-class Rectangle : public Shape {
+class Rectangle final : public Shape {
 public:
     /**
      * @brief Constructs a rectangle with the specified bottom-left and top-right coordinates.
@@ -50,6 +51,38 @@ public:
      */
     Point getCenter() const override;
 
+    /**
+     * @brief Retrieves the axis-aligned bounding box of the rectangle.
+     * @return The smallest axis-aligned box that contains the rectangle.
+     */
+    BoundingBox getBoundingBox() const override;
+
+    /**
+     * @brief Checks if a point lies inside the rectangle.
+     * @param point The point to check.
+     * @return True if the point is inside the rectangle or on its border.
+     */
+    bool contains(const Point& point) const override;
+
+    /**
+     * @brief Calculates the squared distance from a point to the rectangle.
+     * @param point The point.
+     * @return The squared distance (0 for points inside the rectangle or on its border).
+     */
+    double squaredDistance(const Point& point) const override;
+
+    /**
+     * @brief Retrieves the bottom-left coordinates of the rectangle.
+     * @return The bottom-left coordinates of the rectangle.
+     */
+    Point getBottomLeft() const;
+
+    /**
+     * @brief Retrieves the top-right coordinates of the rectangle.
+     * @return The top-right coordinates of the rectangle.
+     */
+    Point getTopRight() const;
+
     /**
      * @brief Gets the name of the shape (in this case, "RECTANGLE").
      * @return The name of the shape as a C-style string.
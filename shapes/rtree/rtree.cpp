@@ -0,0 +1,363 @@
+#include "rtree/rtree.hpp"
+
+#include <algorithm>  // std::sort.
+#include <cmath>      // std::ceil, std::sqrt.
+#include <cstddef>    // std::size_t.
+#include <memory>     // std::make_unique, std::unique_ptr.
+#include <span>       // std::span.
+#include <utility>    // std::move.
+#include <vector>     // std::vector.
+
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "point/point.hpp"                // setm::Point.
+#include "shape/shape.hpp"                // setm::Shape.
+
+namespace setm {
+
+// Leaves hold shapes; internal nodes hold child nodes. boxes[i] bounds entry i.
+struct RTree::Node {
+    bool leaf{ true };
+    std::vector<BoundingBox> boxes;
+    std::vector<std::unique_ptr<Node>> children;  // Used by internal nodes.
+    std::vector<Shape*> shapes;                   // Used by leaves.
+
+    std::size_t count() const {
+        return boxes.size();
+    }
+
+    BoundingBox bounds() const {
+        BoundingBox result{ boxes.front() };
+        for(const BoundingBox& box : boxes) {
+            result = result.merge(box);
+        }
+        return result;
+    }
+};
+
+namespace {
+
+using Node = RTree::Node;
+
+// Nodes with fewer entries are dissolved after a removal (except the root).
+constexpr std::size_t MIN_ENTRIES{ RTree::NODE_CAPACITY / 4 };
+
+double centerX(const BoundingBox& box) {
+    return (box.min.x + box.max.x) * 0.5;
+}
+
+double centerY(const BoundingBox& box) {
+    return (box.min.y + box.max.y) * 0.5;
+}
+
+// Packs items (sorted in STR order) into nodes of up to NODE_CAPACITY entries.
+// Item must provide `box` and be movable into a node with addEntry.
+template<typename Item, typename AddEntry>
+std::vector<std::unique_ptr<Node>> packLevel(std::vector<Item> items, bool leaf, AddEntry addEntry) {
+    const std::size_t capacity{ RTree::NODE_CAPACITY };
+    const std::size_t nodeCount{ (items.size() + capacity - 1) / capacity };
+    const std::size_t sliceCount{ static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(nodeCount)))) };
+    const std::size_t sliceSize{ sliceCount * capacity };
+
+    // Sort by x, cut into vertical slices, and sort each slice by y.
+    std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return centerX(a.box) < centerX(b.box); });
+    for(std::size_t begin{}; begin < items.size(); begin += sliceSize) {
+        const auto first{ items.begin() + static_cast<std::ptrdiff_t>(begin) };
+        const auto last{ items.begin() + static_cast<std::ptrdiff_t>(std::min(items.size(), begin + sliceSize)) };
+        std::sort(first, last, [](const Item& a, const Item& b) { return centerY(a.box) < centerY(b.box); });
+    }
+
+    std::vector<std::unique_ptr<Node>> nodes;
+    nodes.reserve(nodeCount);
+    for(std::size_t i{}; i < items.size(); ++i) {
+        if(i % capacity == 0) {
+            nodes.push_back(std::make_unique<Node>());
+            nodes.back()->leaf = leaf;
+        }
+        addEntry(*nodes.back(), std::move(items[i]));
+    }
+    return nodes;
+}
+
+struct ShapeItem {
+    BoundingBox box;
+    Shape* shape;
+};
+
+struct NodeItem {
+    BoundingBox box;
+    std::unique_ptr<Node> node;
+};
+
+// Splits an overfull node in two along the axis where its entries are most spread out.
+std::unique_ptr<Node> split(Node& node) {
+    double minX{ centerX(node.boxes.front()) };
+    double maxX{ minX };
+    double minY{ centerY(node.boxes.front()) };
+    double maxY{ minY };
+    for(const BoundingBox& box : node.boxes) {
+        minX = std::min(minX, centerX(box));
+        maxX = std::max(maxX, centerX(box));
+        minY = std::min(minY, centerY(box));
+        maxY = std::max(maxY, centerY(box));
+    }
+    const bool byX{ maxX - minX >= maxY - minY };
+
+    std::vector<std::size_t> order(node.count());
+    for(std::size_t i{}; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&node, byX](std::size_t a, std::size_t b) {
+        return byX ? centerX(node.boxes[a]) < centerX(node.boxes[b]) : centerY(node.boxes[a]) < centerY(node.boxes[b]);
+    });
+
+    Node first;
+    auto second{ std::make_unique<Node>() };
+    first.leaf = node.leaf;
+    second->leaf = node.leaf;
+    for(std::size_t i{}; i < order.size(); ++i) {
+        Node& target{ i < order.size() / 2 ? first : *second };
+        target.boxes.push_back(node.boxes[order[i]]);
+        if(node.leaf) {
+            target.shapes.push_back(node.shapes[order[i]]);
+        } else {
+            target.children.push_back(std::move(node.children[order[i]]));
+        }
+    }
+    node = std::move(first);
+    return second;
+}
+
+// Inserts a shape below node; returns the new sibling if node had to be split.
+std::unique_ptr<Node> insertInto(Node& node, const BoundingBox& box, Shape* shape) {
+    if(node.leaf) {
+        node.boxes.push_back(box);
+        node.shapes.push_back(shape);
+    } else {
+        // Choose the child whose box grows the least (then the smallest one).
+        std::size_t best{};
+        double bestGrowth{};
+        double bestArea{};
+        for(std::size_t i{}; i < node.count(); ++i) {
+            const double area{ node.boxes[i].getArea() };
+            const double growth{ node.boxes[i].merge(box).getArea() - area };
+            if(i == 0 || growth < bestGrowth || (growth == bestGrowth && area < bestArea)) {
+                best = i;
+                bestGrowth = growth;
+                bestArea = area;
+            }
+        }
+
+        std::unique_ptr<Node> sibling{ insertInto(*node.children[best], box, shape) };
+        node.boxes[best] = node.children[best]->bounds();
+        if(sibling) {
+            node.boxes.push_back(sibling->bounds());
+            node.children.push_back(std::move(sibling));
+        }
+    }
+
+    if(node.count() > RTree::NODE_CAPACITY) {
+        return split(node);
+    }
+    return nullptr;
+}
+
+// Collects all shapes below node.
+void collect(Node& node, std::vector<Shape*>& shapes) {
+    if(node.leaf) {
+        shapes.insert(shapes.end(), node.shapes.begin(), node.shapes.end());
+        return;
+    }
+    for(const std::unique_ptr<Node>& child : node.children) {
+        collect(*child, shapes);
+    }
+}
+
+// Removes a shape below node. Shapes of dissolved (underfull) nodes are added to orphans.
+bool removeFrom(Node& node, const BoundingBox& box, const Shape* shape, std::vector<Shape*>& orphans) {
+    if(node.leaf) {
+        for(std::size_t i{}; i < node.count(); ++i) {
+            if(node.shapes[i] == shape) {
+                node.boxes.erase(node.boxes.begin() + static_cast<std::ptrdiff_t>(i));
+                node.shapes.erase(node.shapes.begin() + static_cast<std::ptrdiff_t>(i));
+                return true;
+            }
+        }
+        return false;
+    }
+
+    for(std::size_t i{}; i < node.count(); ++i) {
+        if(!node.boxes[i].intersects(box) || !removeFrom(*node.children[i], box, shape, orphans)) {
+            continue;
+        }
+
+        Node& child{ *node.children[i] };
+        if(child.count() < MIN_ENTRIES) {
+            collect(child, orphans);
+            node.boxes.erase(node.boxes.begin() + static_cast<std::ptrdiff_t>(i));
+            node.children.erase(node.children.begin() + static_cast<std::ptrdiff_t>(i));
+        } else {
+            node.boxes[i] = child.bounds();
+        }
+        return true;
+    }
+    return false;
+}
+
+// Visits the shapes of the leaves whose entries pass the box test.
+template<typename BoxTest, typename Visit>
+void search(const Node& root, BoxTest boxTest, Visit visit) {
+    std::vector<const Node*> stack{ &root };
+    while(!stack.empty()) {
+        const Node& node{ *stack.back() };
+        stack.pop_back();
+        for(std::size_t i{}; i < node.count(); ++i) {
+            if(!boxTest(node.boxes[i])) {
+                continue;
+            }
+            if(node.leaf) {
+                visit(node.shapes[i]);
+            } else {
+                stack.push_back(node.children[i].get());
+            }
+        }
+    }
+}
+
+}  // Anonymous namespace.
+
+RTree::RTree() = default;
+
+RTree::RTree(std::span<Shape* const> shapes)
+    : size_{ shapes.size() } {
+    if(shapes.empty()) {
+        return;
+    }
+
+    std::vector<ShapeItem> items;
+    items.reserve(shapes.size());
+    for(Shape* const shape : shapes) {
+        items.push_back({ shape->getBoundingBox(), shape });
+    }
+    std::vector<std::unique_ptr<Node>> level{ packLevel(std::move(items), true, [](Node& node, ShapeItem item) {
+        node.boxes.push_back(item.box);
+        node.shapes.push_back(item.shape);
+    }) };
+
+    // Pack the nodes of each level into parents until one root remains.
+    while(level.size() > 1) {
+        std::vector<NodeItem> nodes;
+        nodes.reserve(level.size());
+        for(std::unique_ptr<Node>& node : level) {
+            const BoundingBox box{ node->bounds() };
+            nodes.push_back({ box, std::move(node) });
+        }
+        level = packLevel(std::move(nodes), false, [](Node& node, NodeItem item) {
+            node.boxes.push_back(item.box);
+            node.children.push_back(std::move(item.node));
+        });
+    }
+    root_ = std::move(level.front());
+}
+
+RTree::RTree(RTree&& other) noexcept = default;
+RTree& RTree::operator=(RTree&& other) noexcept = default;
+RTree::~RTree() = default;
+
+void RTree::insert(Shape* shape) {
+    if(!root_) {
+        root_ = std::make_unique<Node>();
+    }
+
+    std::unique_ptr<Node> sibling{ insertInto(*root_, shape->getBoundingBox(), shape) };
+    if(sibling) {
+        // The root was split: grow the tree by one level.
+        auto root{ std::make_unique<Node>() };
+        root->leaf = false;
+        root->boxes.push_back(root_->bounds());
+        root->boxes.push_back(sibling->bounds());
+        root->children.push_back(std::move(root_));
+        root->children.push_back(std::move(sibling));
+        root_ = std::move(root);
+    }
+    ++size_;
+}
+
+bool RTree::remove(const Shape* shape) {
+    if(!root_) {
+        return false;
+    }
+
+    std::vector<Shape*> orphans;
+    if(!removeFrom(*root_, shape->getBoundingBox(), shape, orphans)) {
+        return false;
+    }
+    --size_;
+
+    // Shrink the tree while the root has a single child.
+    while(!root_->leaf && root_->count() == 1) {
+        root_ = std::move(root_->children.front());
+    }
+    if(root_->count() == 0) {
+        root_.reset();
+    }
+
+    // Shapes of dissolved nodes go back in at the leaf level.
+    size_ -= orphans.size();
+    for(Shape* const orphan : orphans) {
+        insert(orphan);
+    }
+    return true;
+}
+
+std::vector<Shape*> RTree::queryWindow(const BoundingBox& window) const {
+    std::vector<Shape*> result;
+    if(root_) {
+        search(
+            *root_, [&window](const BoundingBox& box) { return box.intersects(window); },
+            [&result](Shape* shape) { result.push_back(shape); });
+    }
+    return result;
+}
+
+std::vector<Shape*> RTree::queryPoint(const Point& point) const {
+    std::vector<Shape*> result;
+    if(root_) {
+        search(
+            *root_, [&point](const BoundingBox& box) { return box.contains(point); },
+            [&result, &point](Shape* shape) {
+                if(shape->contains(point)) {
+                    result.push_back(shape);
+                }
+            });
+    }
+    return result;
+}
+
+std::vector<Shape*> RTree::queryRadius(const Point& center, double radius) const {
+    std::vector<Shape*> result;
+    if(root_) {
+        const double squaredRadius{ radius * radius };
+        search(
+            *root_, [&center, squaredRadius](const BoundingBox& box) { return box.squaredDistance(center) <= squaredRadius; },
+            [&result, &center, squaredRadius](Shape* shape) {
+                if(shape->squaredDistance(center) <= squaredRadius) {
+                    result.push_back(shape);
+                }
+            });
+    }
+    return result;
+}
+
+std::size_t RTree::size() const {
+    return size_;
+}
+
+std::size_t RTree::height() const {
+    std::size_t levels{};
+    for(const Node* node{ root_.get() }; node != nullptr; node = node->leaf ? nullptr : node->children.front().get()) {
+        ++levels;
+    }
+    return levels;
+}
+
+}  // namespace setm
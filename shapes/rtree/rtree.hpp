@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>  // std::size_t.
+#include <memory>   // std::unique_ptr.
+#include <span>     // std::span.
+#include <vector>   // std::vector.
+
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "point/point.hpp"                // setm::Point.
+#include "shape/shape.hpp"                // setm::Shape.
+
+namespace setm {
+
+/**
+ * @brief Spatial index of shapes based on their bounding boxes.
+ *
+ * The tree is bulk-loaded with the Sort-Tile-Recursive (STR) algorithm, which packs
+ * nearby shapes into full nodes, and supports inserting and removing single shapes afterwards.
+ *
+ * The tree does not own the shapes. A shape must not be moved or resized while it is indexed
+ * (remove it, modify it, and insert it again). Const member functions do not modify the tree,
+ * so any number of threads may query it at the same time as long as no thread modifies it.
+ */
+class RTree {
+public:
+    /**
+     * @brief Maximum number of entries per node.
+     */
+    static constexpr std::size_t NODE_CAPACITY{ 16 };
+
+    /**
+     * @brief Constructs an empty tree.
+     */
+    RTree();
+
+    /**
+     * @brief Constructs a tree containing the given shapes (STR bulk load).
+     * @param shapes The shapes to index.
+     */
+    explicit RTree(std::span<Shape* const> shapes);
+
+    RTree(RTree&& other) noexcept;
+    RTree& operator=(RTree&& other) noexcept;
+    ~RTree();
+
+    /**
+     * @brief Adds a shape to the tree.
+     * @param shape The shape to index.
+     */
+    void insert(Shape* shape);
+
+    /**
+     * @brief Removes a shape from the tree.
+     * @param shape The shape to remove.
+     * @return True if the shape was found and removed.
+     */
+    bool remove(const Shape* shape);
+
+    /**
+     * @brief Finds the shapes whose bounding boxes intersect a window.
+     * @param window The window to search.
+     * @return The shapes, in no particular order.
+     */
+    std::vector<Shape*> queryWindow(const BoundingBox& window) const;
+
+    /**
+     * @brief Finds the shapes that contain a point.
+     * @param point The point to search.
+     * @return The shapes, in no particular order.
+     */
+    std::vector<Shape*> queryPoint(const Point& point) const;
+
+    /**
+     * @brief Finds the shapes that lie within a distance of a point.
+     * @param center The point to search around.
+     * @param radius The maximum distance.
+     * @return The shapes, in no particular order.
+     */
+    std::vector<Shape*> queryRadius(const Point& center, double radius) const;
+
+    /**
+     * @brief Gets the number of shapes in the tree.
+     * @return The number of shapes.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Gets the number of levels of the tree (0 for an empty tree).
+     * @return The height of the tree.
+     */
+    std::size_t height() const;
+
+    /**
+     * @brief Node of the tree (defined in rtree.cpp).
+     */
+    struct Node;
+
+private:
+    std::unique_ptr<Node> root_;
+    std::size_t size_{};
+};
+
+}  // namespace setm
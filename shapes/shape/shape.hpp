@@ -3,7 +3,8 @@
 #include <compare>      // std::partial_ordering.
 #include <string_view>  // std::string_view.
 
-#include "point/point.hpp"  // setm::Point.
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "point/point.hpp"                // setm::Point.
 
 namespace setm {
 
@@ -47,6 +48,26 @@ public:
      */
     virtual Point getCenter() const = 0;
 
+    /**
+     * @brief Pure virtual function to retrieve the axis-aligned bounding box of the shape.
+     * @return The smallest axis-aligned box that contains the shape.
+     */
+    virtual BoundingBox getBoundingBox() const = 0;
+
+    /**
+     * @brief Pure virtual function to check if a point lies inside the shape.
+     * @param point The point to check.
+     * @return True if the point is inside the shape or on its border.
+     */
+    virtual bool contains(const Point& point) const = 0;
+
+    /**
+     * @brief Pure virtual function to calculate the squared distance from a point to the shape.
+     * @param point The point.
+     * @return The squared distance (0 for points inside the shape or on its border).
+     */
+    virtual double squaredDistance(const Point& point) const = 0;
+
     /**
      * @brief Pure virtual function to get the name of the shape.
      * @return The name of the shape.
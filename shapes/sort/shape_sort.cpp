@@ -0,0 +1,127 @@
+#include "sort/shape_sort.hpp"
+
+#include <algorithm>  // std::clamp, std::max.
+#include <array>      // std::array.
+#include <bit>        // std::bit_cast.
+#include <cstddef>    // std::size_t.
+#include <cstdint>    // std::uint64_t.
+#include <span>       // std::span.
+#include <thread>     // std::thread.
+#include <vector>     // std::vector.
+
+#include "any/any_shape.hpp"  // setm::AnyShape.
+#include "shape/shape.hpp"    // setm::Shape.
+
+namespace setm {
+
+namespace {
+
+constexpr std::size_t RADIX_BITS{ 8 };
+constexpr std::size_t BUCKETS{ std::size_t{ 1 } << RADIX_BITS };
+constexpr std::size_t PASSES{ 64 / RADIX_BITS };
+
+// Below this many keys per thread, extra threads cost more than they save.
+constexpr std::size_t MIN_KEYS_PER_THREAD{ 1 << 15 };
+
+struct Item {
+    std::uint64_t key;
+    std::size_t index;
+};
+
+// Maps a double to an integer with the same order: negative values have all bits flipped,
+// non-negative values only the sign bit. Adding 0.0 turns -0.0 into 0.0, so both zeros tie.
+std::uint64_t orderedBits(double value) {
+    const std::uint64_t bits{ std::bit_cast<std::uint64_t>(value + 0.0) };
+    const std::uint64_t mask{ (bits >> 63) != 0 ? ~std::uint64_t{} : std::uint64_t{ 1 } << 63 };
+    return bits ^ mask;
+}
+
+std::size_t digitOf(std::uint64_t key, std::size_t pass) {
+    return static_cast<std::size_t>(key >> (pass * RADIX_BITS)) & (BUCKETS - 1);
+}
+
+// Runs task(part) for every part in [0, parts), one thread per part.
+template<typename Task>
+void runParts(std::size_t parts, const Task& task) {
+    std::vector<std::thread> pool;
+    for(std::size_t part{ 1 }; part < parts; ++part) {
+        pool.emplace_back(task, part);
+    }
+    task(0);
+    for(std::thread& thread : pool) {
+        thread.join();
+    }
+}
+
+}  // Anonymous namespace.
+
+std::vector<std::size_t> sortedOrder(std::span<const double> keys, std::size_t threads) {
+    const std::size_t size{ keys.size() };
+    const std::size_t parts{ std::clamp<std::size_t>(threads, 1, std::max<std::size_t>(1, size / MIN_KEYS_PER_THREAD)) };
+    const auto partBegin{ [size, parts](std::size_t part) {
+        return size * part / parts;
+    } };
+
+    std::vector<Item> items(size);
+    std::vector<Item> buffer(size);
+    runParts(parts, [&](std::size_t part) {
+        for(std::size_t i{ partBegin(part) }; i < partBegin(part + 1); ++i) {
+            items[i] = { orderedBits(keys[i]), i };
+        }
+    });
+
+    // Each part counts its digits, then scatters its items behind those of the previous parts,
+    // which keeps every pass stable.
+    std::vector<std::array<std::size_t, BUCKETS>> counts(parts);
+    for(std::size_t pass{}; pass < PASSES; ++pass) {
+        runParts(parts, [&](std::size_t part) {
+            counts[part].fill(0);
+            for(std::size_t i{ partBegin(part) }; i < partBegin(part + 1); ++i) {
+                ++counts[part][digitOf(items[i].key, pass)];
+            }
+        });
+
+        // Skip passes where every key has the same digit (typical for the exponent bytes).
+        const std::size_t firstDigit{ size == 0 ? 0 : digitOf(items[0].key, pass) };
+        std::size_t sameDigit{};
+        for(const std::array<std::size_t, BUCKETS>& count : counts) {
+            sameDigit += count[firstDigit];
+        }
+        if(sameDigit == size) {
+            continue;
+        }
+
+        // Turn the counts into starting offsets, ordered by digit and then by part.
+        std::size_t offset{};
+        for(std::size_t digit{}; digit < BUCKETS; ++digit) {
+            for(std::size_t part{}; part < parts; ++part) {
+                const std::size_t count{ counts[part][digit] };
+                counts[part][digit] = offset;
+                offset += count;
+            }
+        }
+
+        runParts(parts, [&](std::size_t part) {
+            for(std::size_t i{ partBegin(part) }; i < partBegin(part + 1); ++i) {
+                buffer[counts[part][digitOf(items[i].key, pass)]++] = items[i];
+            }
+        });
+        items.swap(buffer);
+    }
+
+    std::vector<std::size_t> order(size);
+    for(std::size_t i{}; i < size; ++i) {
+        order[i] = items[i].index;
+    }
+    return order;
+}
+
+void sortByArea(std::span<Shape*> shapes, std::size_t threads) {
+    sortBy(shapes, [](const Shape* shape) { return shape->getArea(); }, threads);
+}
+
+void sortByArea(std::span<AnyShape> shapes, std::size_t threads) {
+    sortBy(shapes, [](const AnyShape& shape) { return shape.getArea(); }, threads);
+}
+
+}  // namespace setm
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <concepts>     // std::convertible_to, std::invocable.
+#include <cstddef>      // std::size_t.
+#include <functional>   // std::invoke.
+#include <ranges>       // std::ranges::begin, std::ranges::random_access_range, std::ranges::size.
+#include <span>         // std::span.
+#include <type_traits>  // std::invoke_result_t.
+#include <utility>      // std::move.
+#include <vector>       // std::vector.
+
+#include "any/any_shape.hpp"  // setm::AnyShape.
+#include "shape/shape.hpp"    // setm::Shape.
+
+namespace setm {
+
+/**
+ * @brief Computes the order that sorts the given keys in ascending order.
+ *
+ * The keys are sorted with a stable LSD radix sort on their IEEE-754 bit patterns (flipped so
+ * that they compare as unsigned integers). -0.0 and 0.0 are equal keys; negative NaNs come first
+ * and positive NaNs last.
+ *
+ * @param keys The keys to sort.
+ * @param threads The number of threads to use (at least one is used).
+ * @return The indices of the keys in sorted order.
+ */
+std::vector<std::size_t> sortedOrder(std::span<const double> keys, std::size_t threads = 1);
+
+/**
+ * @brief Sorts a range by a key, computing the key of each element only once.
+ *
+ * The sort is stable. Elements are moved into their sorted positions once the order is known.
+ *
+ * @param range The range to sort.
+ * @param key Callable returning the key (convertible to double) of an element.
+ * @param threads The number of threads to use for the radix sort.
+ */
+template<std::ranges::random_access_range Range, typename Key>
+    requires std::invocable<Key&, std::ranges::range_reference_t<Range>> &&
+             std::convertible_to<std::invoke_result_t<Key&, std::ranges::range_reference_t<Range>>, double>
+void sortBy(Range&& range, Key key, std::size_t threads = 1) {
+    const std::size_t size{ static_cast<std::size_t>(std::ranges::size(range)) };
+    const auto first{ std::ranges::begin(range) };
+
+    std::vector<double> keys;
+    keys.reserve(size);
+    for(std::size_t i{}; i < size; ++i) {
+        keys.push_back(static_cast<double>(std::invoke(key, first[i])));
+    }
+
+    const std::vector<std::size_t> order{ sortedOrder(keys, threads) };
+    std::vector<std::ranges::range_value_t<Range>> sorted;
+    sorted.reserve(size);
+    for(const std::size_t index : order) {
+        sorted.push_back(std::move(first[index]));
+    }
+    for(std::size_t i{}; i < size; ++i) {
+        first[i] = std::move(sorted[i]);
+    }
+}
+
+/**
+ * @brief Sorts shapes by area in ascending order, calling getArea once per shape.
+ * @param shapes The shapes to sort.
+ * @param threads The number of threads to use for the radix sort.
+ */
+void sortByArea(std::span<Shape*> shapes, std::size_t threads = 1);
+
+/**
+ * @brief Sorts shapes by area in ascending order, calling getArea once per shape.
+ * @param shapes The shapes to sort.
+ * @param threads The number of threads to use for the radix sort.
+ */
+void sortByArea(std::span<AnyShape> shapes, std::size_t threads = 1);
+
+}  // namespace setm
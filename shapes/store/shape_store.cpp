@@ -0,0 +1,238 @@
+#include "store/shape_store.hpp"
+
+#include <cmath>        // std::abs.
+#include <cstddef>      // std::size_t.
+#include <cstdint>      // std::uint32_t.
+#include <numbers>      // std::numbers::pi_v.
+#include <span>         // std::span.
+#include <stdexcept>    // std::invalid_argument.
+#include <string_view>  // std::string_view.
+#include <vector>       // std::vector.
+
+#include "bounding_box/bounding_box.hpp"  // setm::BoundingBox.
+#include "circle/circle.hpp"              // setm::Circle.
+#include "point/point.hpp"                // setm::Point.
+#include "rectangle/rectangle.hpp"        // setm::Rectangle.
+
+namespace setm {
+
+namespace {
+
+// Removes the element at index by moving the last element into its place.
+template<typename T>
+void swapRemove(std::vector<T>& values, std::size_t index) {
+    values[index] = values.back();
+    values.pop_back();
+}
+
+}  // Anonymous namespace.
+
+ShapeStore::Handle ShapeStore::addCircle(const Point& center, double radius) {
+    if(radius <= 0) {
+        throw std::invalid_argument("Invalid circle radius");
+    }
+
+    const Handle handle{ allocateSlot(Kind::Circle, radii_.size()) };
+    circleX_.push_back(center.x);
+    circleY_.push_back(center.y);
+    radii_.push_back(radius);
+    circleSlots_.push_back(handle.slot_);
+    return handle;
+}
+
+ShapeStore::Handle ShapeStore::add(const Circle& circle) {
+    // A circle scaled by a negative factor has a negative radius.
+    return addCircle(circle.getCenter(), std::abs(circle.getRadius()));
+}
+
+ShapeStore::Handle ShapeStore::addRectangle(const Point& bottomLeft, const Point& topRight) {
+    if(bottomLeft.x >= topRight.x || bottomLeft.y >= topRight.y) {
+        throw std::invalid_argument("Invalid rectangle coordinates");
+    }
+
+    const Handle handle{ allocateSlot(Kind::Rectangle, minX_.size()) };
+    minX_.push_back(bottomLeft.x);
+    minY_.push_back(bottomLeft.y);
+    maxX_.push_back(topRight.x);
+    maxY_.push_back(topRight.y);
+    rectangleSlots_.push_back(handle.slot_);
+    return handle;
+}
+
+ShapeStore::Handle ShapeStore::add(const Rectangle& rectangle) {
+    // A rectangle scaled by a negative factor has swapped corners; its bounding box is normalized.
+    const BoundingBox box{ rectangle.getBoundingBox() };
+    return addRectangle(box.min, box.max);
+}
+
+void ShapeStore::remove(Handle handle) {
+    const Slot& removed{ slotOf(handle) };
+    const std::size_t index{ removed.index };
+
+    // The last shape of the same kind moves into the freed position.
+    if(removed.kind == Kind::Circle) {
+        slots_[circleSlots_.back()].index = static_cast<std::uint32_t>(index);
+        swapRemove(circleX_, index);
+        swapRemove(circleY_, index);
+        swapRemove(radii_, index);
+        swapRemove(circleSlots_, index);
+    } else {
+        slots_[rectangleSlots_.back()].index = static_cast<std::uint32_t>(index);
+        swapRemove(minX_, index);
+        swapRemove(minY_, index);
+        swapRemove(maxX_, index);
+        swapRemove(maxY_, index);
+        swapRemove(rectangleSlots_, index);
+    }
+
+    Slot& slot{ slots_[handle.slot_] };
+    slot.alive = false;
+    if(++slot.generation == 0) {
+        slot.generation = 1;
+    }
+    freeSlots_.push_back(handle.slot_);
+}
+
+bool ShapeStore::contains(Handle handle) const {
+    return handle.slot_ < slots_.size() && slots_[handle.slot_].alive && slots_[handle.slot_].generation == handle.generation_;
+}
+
+double ShapeStore::getArea(Handle handle) const {
+    const Slot& slot{ slotOf(handle) };
+    const std::size_t i{ slot.index };
+    if(slot.kind == Kind::Circle) {
+        return std::numbers::pi_v<double> * radii_[i] * radii_[i];
+    }
+    return (maxX_[i] - minX_[i]) * (maxY_[i] - minY_[i]);
+}
+
+Point ShapeStore::getCenter(Handle handle) const {
+    const Slot& slot{ slotOf(handle) };
+    const std::size_t i{ slot.index };
+    if(slot.kind == Kind::Circle) {
+        return { circleX_[i], circleY_[i] };
+    }
+    return { (minX_[i] + maxX_[i]) * 0.5, (minY_[i] + maxY_[i]) * 0.5 };
+}
+
+std::string_view ShapeStore::getName(Handle handle) const {
+    return slotOf(handle).kind == Kind::Circle ? "CIRCLE" : "RECTANGLE";
+}
+
+void ShapeStore::areas(std::span<double> out) const {
+    checkSize(out.size());
+
+    const std::size_t circles{ radii_.size() };
+    const double* const radii{ radii_.data() };
+    for(std::size_t i{}; i < circles; ++i) {
+        out[i] = std::numbers::pi_v<double> * radii[i] * radii[i];
+    }
+
+    double* const rectangleAreas{ out.data() + circles };
+    const double* const minX{ minX_.data() };
+    const double* const minY{ minY_.data() };
+    const double* const maxX{ maxX_.data() };
+    const double* const maxY{ maxY_.data() };
+    for(std::size_t i{}; i < minX_.size(); ++i) {
+        rectangleAreas[i] = (maxX[i] - minX[i]) * (maxY[i] - minY[i]);
+    }
+}
+
+std::vector<double> ShapeStore::areas() const {
+    std::vector<double> result(size());
+    areas(result);
+    return result;
+}
+
+void ShapeStore::centers(std::span<Point> out) const {
+    checkSize(out.size());
+
+    const std::size_t circles{ radii_.size() };
+    for(std::size_t i{}; i < circles; ++i) {
+        out[i] = { circleX_[i], circleY_[i] };
+    }
+    for(std::size_t i{}; i < minX_.size(); ++i) {
+        out[circles + i] = { (minX_[i] + maxX_[i]) * 0.5, (minY_[i] + maxY_[i]) * 0.5 };
+    }
+}
+
+std::vector<Point> ShapeStore::centers() const {
+    std::vector<Point> result(size());
+    centers(result);
+    return result;
+}
+
+void ShapeStore::scaleAll(double factor) {
+    if(factor == 0.0) {
+        throw std::invalid_argument("Invalid scale factor. Cannot scale by a factor of 0.");
+    }
+
+    // Shapes are kept normalized, as add() stores them: a negative factor mirrors them in place.
+    const double magnitude{ std::abs(factor) };
+    for(double& radius : radii_) {
+        radius *= magnitude;
+    }
+
+    double* const minX{ minX_.data() };
+    double* const minY{ minY_.data() };
+    double* const maxX{ maxX_.data() };
+    double* const maxY{ maxY_.data() };
+    for(std::size_t i{}; i < minX_.size(); ++i) {
+        const double centerX{ (minX[i] + maxX[i]) * 0.5 };
+        const double centerY{ (minY[i] + maxY[i]) * 0.5 };
+        const double halfWidth{ (maxX[i] - minX[i]) * 0.5 * magnitude };
+        const double halfHeight{ (maxY[i] - minY[i]) * 0.5 * magnitude };
+        minX[i] = centerX - halfWidth;
+        minY[i] = centerY - halfHeight;
+        maxX[i] = centerX + halfWidth;
+        maxY[i] = centerY + halfHeight;
+    }
+}
+
+std::vector<ShapeStore::Handle> ShapeStore::handles() const {
+    std::vector<Handle> result;
+    result.reserve(size());
+    for(const std::uint32_t slot : circleSlots_) {
+        result.push_back({ slot, slots_[slot].generation });
+    }
+    for(const std::uint32_t slot : rectangleSlots_) {
+        result.push_back({ slot, slots_[slot].generation });
+    }
+    return result;
+}
+
+std::size_t ShapeStore::size() const {
+    return radii_.size() + minX_.size();
+}
+
+ShapeStore::Handle ShapeStore::allocateSlot(Kind kind, std::size_t index) {
+    std::uint32_t slot{};
+    if(freeSlots_.empty()) {
+        slot = static_cast<std::uint32_t>(slots_.size());
+        slots_.emplace_back();
+    } else {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    }
+
+    Slot& data{ slots_[slot] };
+    data.index = static_cast<std::uint32_t>(index);
+    data.kind = kind;
+    data.alive = true;
+    return { slot, data.generation };
+}
+
+const ShapeStore::Slot& ShapeStore::slotOf(Handle handle) const {
+    if(!contains(handle)) {
+        throw std::invalid_argument("Invalid shape handle");
+    }
+    return slots_[handle.slot_];
+}
+
+void ShapeStore::checkSize(std::size_t size) const {
+    if(size != this->size()) {
+        throw std::invalid_argument("Output size does not match the number of shapes");
+    }
+}
+
+}  // namespace setm
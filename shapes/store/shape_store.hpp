@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>      // std::size_t.
+#include <cstdint>      // std::uint32_t.
+#include <span>         // std::span.
+#include <string_view>  // std::string_view.
+#include <vector>       // std::vector.
+
+#include "circle/circle.hpp"        // setm::Circle.
+#include "point/point.hpp"          // setm::Point.
+#include "rectangle/rectangle.hpp"  // setm::Rectangle.
+
+namespace setm {
+
+/**
+ * @brief Stores circles and rectangles as structures of arrays.
+ *
+ * Every coordinate and radius lives in its own contiguous array, one set of arrays per
+ * shape type, so the batch kernels (areas, centers, scaleAll) are plain loops without
+ * virtual calls that the compiler can vectorize.
+ *
+ * Shapes are referred to by handles that stay valid until the shape is removed, even though
+ * removal moves other shapes inside the arrays. The batch kernels write their results in
+ * "dense order" (all circles, then all rectangles); handles() lists the handle at each position.
+ */
+class ShapeStore {
+public:
+    /**
+     * @brief Stable reference to a shape of the store.
+     *
+     * A default-constructed handle never refers to a shape.
+     */
+    class Handle {
+    public:
+        Handle() = default;
+
+        bool operator==(const Handle& other) const = default;
+
+    private:
+        friend class ShapeStore;
+
+        Handle(std::uint32_t slot, std::uint32_t generation)
+            : slot_{ slot }, generation_{ generation } {}
+
+        std::uint32_t slot_{};        // Index in the slot table.
+        std::uint32_t generation_{};  // Must match the slot's generation for the handle to be valid.
+    };
+
+    /**
+     * @brief Adds a circle to the store.
+     * @return Handle to the new shape.
+     * @throws std::invalid_argument if the shape is not valid (as in the Circle constructor).
+     */
+    Handle addCircle(const Point& center, double radius);
+    Handle add(const Circle& circle);
+
+    /**
+     * @brief Adds a rectangle to the store.
+     * @return Handle to the new shape.
+     * @throws std::invalid_argument if the shape is not valid (as in the Rectangle constructor).
+     */
+    Handle addRectangle(const Point& bottomLeft, const Point& topRight);
+    Handle add(const Rectangle& rectangle);
+
+    /**
+     * @brief Removes a shape from the store; its handle becomes invalid.
+     * @param handle The shape to remove.
+     * @throws std::invalid_argument if the handle is not valid.
+     */
+    void remove(Handle handle);
+
+    /**
+     * @brief Checks if a handle refers to a shape of the store.
+     * @param handle The handle to check.
+     * @return True if the shape has not been removed.
+     */
+    bool contains(Handle handle) const;
+
+    /**
+     * @brief Calculates the area of a single shape.
+     * @throws std::invalid_argument if the handle is not valid.
+     */
+    double getArea(Handle handle) const;
+
+    /**
+     * @brief Retrieves the center of a single shape.
+     * @throws std::invalid_argument if the handle is not valid.
+     */
+    Point getCenter(Handle handle) const;
+
+    /**
+     * @brief Gets the name of a single shape ("CIRCLE" or "RECTANGLE").
+     * @throws std::invalid_argument if the handle is not valid.
+     */
+    std::string_view getName(Handle handle) const;
+
+    /**
+     * @brief Calculates the areas of all shapes, in dense order.
+     * @param out Receives the areas.
+     * @throws std::invalid_argument if the size of out is not size().
+     */
+    void areas(std::span<double> out) const;
+    std::vector<double> areas() const;
+
+    /**
+     * @brief Retrieves the centers of all shapes, in dense order.
+     * @param out Receives the centers.
+     * @throws std::invalid_argument if the size of out is not size().
+     */
+    void centers(std::span<Point> out) const;
+    std::vector<Point> centers() const;
+
+    /**
+     * @brief Scales every shape isotropically relative to its center (as Shape::scale does).
+     * @param factor The scaling factor.
+     * @throws std::invalid_argument if the provided factor is not valid (is equal to 0).
+     */
+    void scaleAll(double factor);
+
+    /**
+     * @brief Lists the handles of all shapes, in dense order.
+     * @return The handles.
+     */
+    std::vector<Handle> handles() const;
+
+    /**
+     * @brief Gets the number of shapes in the store.
+     * @return The number of shapes.
+     */
+    std::size_t size() const;
+
+private:
+    enum class Kind : std::uint8_t { Circle, Rectangle };
+
+    struct Slot {
+        std::uint32_t index{};       // Position in the arrays of the shape's kind.
+        std::uint32_t generation{ 1 };  // Incremented when the shape is removed; never 0, the generation of default handles.
+        Kind kind{ Kind::Circle };
+        bool alive{ false };
+    };
+
+    Handle allocateSlot(Kind kind, std::size_t index);
+    const Slot& slotOf(Handle handle) const;
+    void checkSize(std::size_t size) const;
+
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> freeSlots_;
+
+    // Circles.
+    std::vector<double> circleX_;
+    std::vector<double> circleY_;
+    std::vector<double> radii_;
+    std::vector<std::uint32_t> circleSlots_;  // Slot of the circle at each position.
+
+    // Rectangles.
+    std::vector<double> minX_;
+    std::vector<double> minY_;
+    std::vector<double> maxX_;
+    std::vector<double> maxY_;
+    std::vector<std::uint32_t> rectangleSlots_;  // Slot of the rectangle at each position.
+};
+
+}  // namespace setm
@@ -1,13 +1,27 @@
-#include <algorithm>    // std::ranges::sort.
+#include <algorithm>    // std::ranges::is_sorted, std::ranges::sort, std::ranges::stable_sort.
+#include <cmath>        // std::round.
 #include <cstddef>      // std::size_t.
+#include <functional>   // std::greater.
+#include <limits>       // std::numeric_limits.
+#include <memory>       // std::unique_ptr, std::make_unique.
 #include <numbers>      // std::numbers::pi_v.
+#include <random>       // std::mt19937, std::uniform_real_distribution.
 #include <string_view>  // std::string_view.
+#include <thread>       // std::thread.
+#include <stdexcept>    // std::invalid_argument, std::logic_error.
+#include <variant>      // std::get_if.
 #include <vector>       // std::vector.
 
-#include "point/point.hpp"          // setm::Point.
-#include "shape/shape.hpp"          // setm::Shape.
-#include "rectangle/rectangle.hpp"  // setm::Rectangle.
-#include "circle/circle.hpp"        // setm::Circle.
+#include "point/point.hpp"            // setm::Point.
+#include "shape/shape.hpp"            // setm::Shape.
+#include "rectangle/rectangle.hpp"    // setm::Rectangle.
+#include "circle/circle.hpp"          // setm::Circle.
+#include "store/shape_store.hpp"      // setm::ShapeStore.
+#include "any/any_shape.hpp"          // setm::AnyShape.
+#include "rtree/rtree.hpp"            // setm::RTree.
+#include "collision/collision.hpp"    // setm::CollisionGrid, setm::overlaps.
+#include "sort/shape_sort.hpp"        // setm::sortBy, setm::sortByArea, setm::sortedOrder.
+#include "factory/shape_factory.hpp"  // setm::ShapeFactory.
 
 #include <gtest/gtest.h>  // Google Test.
 
@@ -103,3 +117,550 @@ TEST(SortingTest, CompareShapes) {
         delete shapes[i];
     }
 }
+
+TEST(ShapeStoreTest, BatchKernelsMatchShapes) {
+    setm::ShapeStore store;
+    std::vector<setm::Circle> circles;
+    std::vector<setm::Rectangle> rectangles;
+    for(int i{}; i < 100; ++i) {
+        circles.emplace_back(setm::Point{ i * 1.0, -i * 2.0 }, 1.0 + i);
+        rectangles.emplace_back(setm::Point{ -i * 1.0, 0.0 }, setm::Point{ i + 1.0, i * 0.5 + 1.0 });
+        store.add(circles.back());
+        store.add(rectangles.back());
+    }
+
+    // Test invalid shapes.
+    EXPECT_THROW(store.addCircle({ 0, 0 }, 0.0), std::invalid_argument);
+    EXPECT_THROW(store.addRectangle({ 0, 0 }, { 2, 0 }), std::invalid_argument);
+    EXPECT_THROW(store.scaleAll(0.0), std::invalid_argument);
+
+    // Scale both the store and the objects, then compare in dense order (circles first).
+    store.scaleAll(1.5);
+    for(std::size_t i{}; i < circles.size(); ++i) {
+        circles[i].scale(1.5);
+        rectangles[i].scale(1.5);
+    }
+
+    const std::vector<double> areas{ store.areas() };
+    const std::vector<setm::Point> centers{ store.centers() };
+    ASSERT_EQ(areas.size(), 200U);
+    for(std::size_t i{}; i < circles.size(); ++i) {
+        EXPECT_DOUBLE_EQ(areas[i], circles[i].getArea());
+        EXPECT_DOUBLE_EQ(areas[100 + i], rectangles[i].getArea());
+        EXPECT_DOUBLE_EQ(centers[i].x, circles[i].getCenter().x);
+        EXPECT_DOUBLE_EQ(centers[100 + i].y, rectangles[i].getCenter().y);
+    }
+
+    std::vector<double> tooSmall(1);
+    EXPECT_THROW(store.areas(tooSmall), std::invalid_argument);
+
+    // Shapes scaled by a negative factor are stored normalized.
+    setm::Circle mirroredCircle{ { 1, 1 }, 2.0 };
+    mirroredCircle.scale(-1.5);
+    setm::Rectangle mirroredRectangle{ { 0, 0 }, { 2, 4 } };
+    mirroredRectangle.scale(-0.5);
+    const setm::ShapeStore::Handle circle{ store.add(mirroredCircle) };
+    const setm::ShapeStore::Handle rectangle{ store.add(mirroredRectangle) };
+    EXPECT_DOUBLE_EQ(store.getArea(circle), mirroredCircle.getArea());
+    EXPECT_DOUBLE_EQ(store.getArea(rectangle), mirroredRectangle.getArea());
+    EXPECT_DOUBLE_EQ(store.getCenter(rectangle).y, 2.0);
+}
+
+TEST(ShapeStoreTest, NegativeScaleAll) {
+    setm::ShapeStore store;
+    std::vector<setm::Circle> circles;
+    std::vector<setm::Rectangle> rectangles;
+    for(int i{}; i < 10; ++i) {
+        circles.emplace_back(setm::Point{ i * 1.0, 3.0 }, 1.0 + i);
+        rectangles.emplace_back(setm::Point{ i * 1.0, -1.0 }, setm::Point{ i + 2.0, i * 0.5 });
+        store.add(circles.back());
+        store.add(rectangles.back());
+    }
+
+    // Mirror both the store and the objects; the store stays normalized.
+    store.scaleAll(-2.0);
+    setm::ShapeStore readded;
+    for(std::size_t i{}; i < circles.size(); ++i) {
+        circles[i].scale(-2.0);
+        rectangles[i].scale(-2.0);
+        readded.add(circles[i]);
+        readded.add(rectangles[i]);
+    }
+
+    const std::vector<double> areas{ store.areas() };
+    const std::vector<setm::Point> centers{ store.centers() };
+    const std::vector<double> readdedAreas{ readded.areas() };
+    const std::vector<setm::Point> readdedCenters{ readded.centers() };
+    ASSERT_EQ(areas.size(), 20U);
+    for(std::size_t i{}; i < circles.size(); ++i) {
+        EXPECT_DOUBLE_EQ(areas[i], circles[i].getArea());
+        EXPECT_DOUBLE_EQ(areas[10 + i], rectangles[i].getArea());
+        EXPECT_DOUBLE_EQ(centers[i].x, circles[i].getCenter().x);
+        EXPECT_DOUBLE_EQ(centers[10 + i].x, rectangles[i].getCenter().x);
+        EXPECT_DOUBLE_EQ(centers[10 + i].y, rectangles[i].getCenter().y);
+    }
+    for(std::size_t i{}; i < areas.size(); ++i) {
+        EXPECT_DOUBLE_EQ(areas[i], readdedAreas[i]);
+        EXPECT_DOUBLE_EQ(centers[i].x, readdedCenters[i].x);
+        EXPECT_DOUBLE_EQ(centers[i].y, readdedCenters[i].y);
+    }
+}
+
+TEST(ShapeStoreTest, StableHandles) {
+    setm::ShapeStore store;
+    const setm::ShapeStore::Handle first{ store.addCircle({ 0, 0 }, 1.0) };
+    const setm::ShapeStore::Handle second{ store.addCircle({ 5, 5 }, 2.0) };
+    const setm::ShapeStore::Handle third{ store.addRectangle({ 0, 0 }, { 2, 3 }) };
+
+    // A default-constructed handle never refers to a shape, not even the first one added.
+    EXPECT_FALSE(store.contains(setm::ShapeStore::Handle{}));
+    EXPECT_THROW(store.remove(setm::ShapeStore::Handle{}), std::invalid_argument);
+    EXPECT_EQ(store.size(), 3U);
+
+    // Removing the first circle moves the second one, but its handle stays valid.
+    store.remove(first);
+    EXPECT_FALSE(store.contains(first));
+    EXPECT_TRUE(store.contains(second));
+    EXPECT_EQ(store.size(), 2U);
+    EXPECT_DOUBLE_EQ(store.getArea(second), std::numbers::pi_v<double> * 2.0 * 2.0);
+    EXPECT_DOUBLE_EQ(store.getCenter(second).x, 5.0);
+    EXPECT_DOUBLE_EQ(store.getArea(third), 6.0);
+    EXPECT_EQ(store.getName(third), "RECTANGLE");
+
+    // A stale handle is rejected, even after its slot has been reused.
+    const setm::ShapeStore::Handle reused{ store.addCircle({ 1, 1 }, 3.0) };
+    EXPECT_THROW(store.remove(first), std::invalid_argument);
+    EXPECT_THROW(static_cast<void>(store.getArea(first)), std::invalid_argument);
+    EXPECT_TRUE(store.contains(reused));
+
+    // Handles are listed in the same order as the batch results.
+    const std::vector<setm::ShapeStore::Handle> handles{ store.handles() };
+    const std::vector<double> areas{ store.areas() };
+    for(std::size_t i{}; i < handles.size(); ++i) {
+        EXPECT_DOUBLE_EQ(areas[i], store.getArea(handles[i]));
+    }
+}
+
+TEST(AnyShapeTest, ValueSemantics) {
+    // Shapes are stored by value, contiguously.
+    std::vector<setm::AnyShape> shapes{
+        setm::Rectangle({ 0, 0 }, { 2, 3 }),
+        setm::Circle({ 2, 2 }, 3.0),
+        setm::Rectangle({ -1, -1 }, { 1, 1 }),
+        setm::Circle({ 5, 5 }, 2.0),
+        setm::Rectangle({ 1, 1 }, { 4, 4 })
+    };
+
+    // Vector of expected areas.
+    const std::vector<double> expected_areas{
+        4.0,
+        6.0,
+        9.0,
+        std::numbers::pi_v<double> * 2.0 * 2.0,
+        std::numbers::pi_v<double> * 3.0 * 3.0
+    };
+
+    // Sort shapes by area in ascending order, without dereferencing.
+    std::ranges::sort(shapes, [](const setm::AnyShape& lhs, const setm::AnyShape& rhs) { return lhs < rhs; });
+    for(std::size_t i{}; i < shapes.size(); ++i) {
+        EXPECT_DOUBLE_EQ(shapes[i].getArea(), expected_areas[i]);
+    }
+
+    // Operations are forwarded to the held shape.
+    setm::AnyShape& circle{ shapes.back() };
+    EXPECT_EQ(circle.getName(), "CIRCLE");
+    circle.scale(2.0);
+    EXPECT_DOUBLE_EQ(circle.getArea(), std::numbers::pi_v<double> * 6.0 * 6.0);
+    EXPECT_DOUBLE_EQ(circle.getCenter().x, 2.0);
+    EXPECT_THROW(circle.scale(0.0), std::invalid_argument);
+    ASSERT_NE(std::get_if<setm::Circle>(&circle.asVariant()), nullptr);
+    EXPECT_DOUBLE_EQ(std::get_if<setm::Circle>(&circle.asVariant())->getRadius(), 6.0);
+    EXPECT_EQ(shapes.front().getName(), "RECTANGLE");
+}
+
+TEST(BoundingBoxTest, Shapes) {
+    const setm::Circle circle({ 5, 5 }, 2.0);
+    const setm::BoundingBox circleBox{ circle.getBoundingBox() };
+    EXPECT_DOUBLE_EQ(circleBox.min.x, 3.0);
+    EXPECT_DOUBLE_EQ(circleBox.max.y, 7.0);
+    EXPECT_TRUE(circle.contains({ 6, 6 }));
+    EXPECT_FALSE(circle.contains({ 6.5, 6.5 }));  // Inside the box, outside the circle.
+
+    // Scaling by a negative factor keeps the box valid.
+    setm::Rectangle rectangle({ 0, 0 }, { 2, 3 });
+    rectangle.scale(-1.0);
+    const setm::BoundingBox rectangleBox{ rectangle.getBoundingBox() };
+    EXPECT_DOUBLE_EQ(rectangleBox.min.x, 0.0);
+    EXPECT_DOUBLE_EQ(rectangleBox.max.y, 3.0);
+    EXPECT_TRUE(rectangle.contains({ 2, 3 }));
+    EXPECT_FALSE(rectangle.contains({ 2.5, 1 }));
+}
+
+namespace {
+
+// Random circles and rectangles in [0, 1000]^2 (fixed seed).
+std::vector<std::unique_ptr<setm::Shape>> makeShapes(std::size_t count, unsigned seed) {
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<double> position{ 0.0, 1000.0 };
+    std::uniform_real_distribution<double> size{ 0.5, 20.0 };
+    std::vector<std::unique_ptr<setm::Shape>> shapes;
+    for(std::size_t i{}; i < count; ++i) {
+        const setm::Point point{ position(generator), position(generator) };
+        if(i % 2 == 0) {
+            shapes.push_back(std::make_unique<setm::Circle>(point, size(generator)));
+        } else {
+            shapes.push_back(std::make_unique<setm::Rectangle>(point, setm::Point{ point.x + size(generator), point.y + size(generator) }));
+        }
+    }
+    return shapes;
+}
+
+// Checks every kind of query against a linear scan.
+void expectMatchesLinearScan(const setm::RTree& tree, const std::vector<setm::Shape*>& shapes, unsigned seed) {
+    std::mt19937 generator{ seed };
+    std::uniform_real_distribution<double> position{ -50.0, 1050.0 };
+    for(int query{}; query < 30; ++query) {
+        const setm::Point point{ position(generator), position(generator) };
+        const setm::BoundingBox window{ point, { point.x + 60, point.y + 40 } };
+        std::vector<setm::Shape*> inWindow;
+        std::vector<setm::Shape*> atPoint;
+        std::vector<setm::Shape*> inRadius;
+        for(setm::Shape* const shape : shapes) {
+            if(shape->getBoundingBox().intersects(window)) {
+                inWindow.push_back(shape);
+            }
+            if(shape->contains(point)) {
+                atPoint.push_back(shape);
+            }
+            if(shape->squaredDistance(point) <= 25.0 * 25.0) {
+                inRadius.push_back(shape);
+            }
+        }
+
+        std::vector<setm::Shape*> result{ tree.queryWindow(window) };
+        std::ranges::sort(result);
+        std::ranges::sort(inWindow);
+        EXPECT_EQ(result, inWindow);
+        result = tree.queryPoint(point);
+        std::ranges::sort(result);
+        std::ranges::sort(atPoint);
+        EXPECT_EQ(result, atPoint);
+        result = tree.queryRadius(point, 25.0);
+        std::ranges::sort(result);
+        std::ranges::sort(inRadius);
+        EXPECT_EQ(result, inRadius);
+    }
+}
+
+}  // Anonymous namespace.
+
+TEST(RTreeTest, BulkLoadInsertRemove) {
+    const std::vector<std::unique_ptr<setm::Shape>> owned{ makeShapes(5000, 1) };
+    std::vector<setm::Shape*> shapes;
+    for(const std::unique_ptr<setm::Shape>& shape : owned) {
+        shapes.push_back(shape.get());
+    }
+
+    // Bulk load the first 4000 shapes, then insert the rest one by one.
+    setm::RTree tree{ std::span<setm::Shape* const>{ shapes }.first(4000) };
+    EXPECT_EQ(tree.size(), 4000U);
+    EXPECT_EQ(tree.height(), 3U);  // 250 leaves, 16 internal nodes, one root.
+    for(std::size_t i{ 4000 }; i < shapes.size(); ++i) {
+        tree.insert(shapes[i]);
+    }
+    EXPECT_EQ(tree.size(), 5000U);
+    expectMatchesLinearScan(tree, shapes, 2);
+
+    // Remove every third shape.
+    std::vector<setm::Shape*> remaining;
+    for(std::size_t i{}; i < shapes.size(); ++i) {
+        if(i % 3 == 0) {
+            EXPECT_TRUE(tree.remove(shapes[i]));
+        } else {
+            remaining.push_back(shapes[i]);
+        }
+    }
+    EXPECT_FALSE(tree.remove(shapes[0]));
+    EXPECT_EQ(tree.size(), remaining.size());
+    expectMatchesLinearScan(tree, remaining, 3);
+
+    // Remove everything.
+    for(setm::Shape* const shape : remaining) {
+        EXPECT_TRUE(tree.remove(shape));
+    }
+    EXPECT_EQ(tree.size(), 0U);
+    EXPECT_EQ(tree.height(), 0U);
+    EXPECT_TRUE(tree.queryWindow({ { 0, 0 }, { 1000, 1000 } }).empty());
+}
+
+TEST(RTreeTest, RadiusQueryIsExact) {
+    // The corner of the circle's box is within the radius, the circle itself is not.
+    setm::Circle circle{ { 0, 0 }, 1 };
+    setm::Rectangle rectangle{ { 2, -1 }, { 3, 1 } };
+    std::vector<setm::Shape*> shapes{ &circle, &rectangle };
+    const setm::RTree tree{ shapes };
+    EXPECT_TRUE(tree.queryRadius({ 1.2, 1.2 }, 0.5).empty());
+    EXPECT_EQ(tree.queryRadius({ 1.2, 1.2 }, 0.75), std::vector<setm::Shape*>{ &circle });
+    EXPECT_EQ(tree.queryRadius({ 1.5, 0 }, 0.5).size(), 2U);  // Touches both.
+
+    EXPECT_DOUBLE_EQ(circle.squaredDistance({ 3, 4 }), 16.0);
+    EXPECT_DOUBLE_EQ(circle.squaredDistance({ 0.5, 0 }), 0.0);
+    EXPECT_DOUBLE_EQ(rectangle.squaredDistance({ 0, 2 }), 5.0);
+    EXPECT_DOUBLE_EQ(rectangle.squaredDistance({ 2.5, 0 }), 0.0);
+    rectangle.scale(-1);
+    EXPECT_DOUBLE_EQ(rectangle.squaredDistance({ 0, 2 }), 5.0);
+}
+
+TEST(RTreeTest, ConcurrentQueries) {
+    const std::vector<std::unique_ptr<setm::Shape>> owned{ makeShapes(20000, 4) };
+    std::vector<setm::Shape*> shapes;
+    for(const std::unique_ptr<setm::Shape>& shape : owned) {
+        shapes.push_back(shape.get());
+    }
+    const setm::RTree tree{ shapes };
+
+    // Const queries from several threads at once.
+    std::vector<std::thread> threads;
+    for(unsigned seed{ 10 }; seed < 14; ++seed) {
+        threads.emplace_back([&tree, &shapes, seed] { expectMatchesLinearScan(tree, shapes, seed); });
+    }
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+TEST(CollisionTest, NarrowPhase) {
+    const setm::Circle circle{ { 0, 0 }, 1 };
+    EXPECT_TRUE(setm::overlaps(circle, setm::Circle{ { 1.5, 0 }, 0.5 }));   // Touching.
+    EXPECT_FALSE(setm::overlaps(circle, setm::Circle{ { 1.5, 1.5 }, 0.5 }));
+
+    const setm::Rectangle rectangle{ { 0, 0 }, { 2, 1 } };
+    EXPECT_TRUE(setm::overlaps(rectangle, setm::Rectangle{ { 2, 1 }, { 3, 3 } }));  // Corners touch.
+    EXPECT_FALSE(setm::overlaps(rectangle, setm::Rectangle{ { 2.1, 0 }, { 3, 1 } }));
+
+    // The circle reaches the rectangle's edges but not its corner.
+    const setm::Rectangle corner{ { 0.8, 0.8 }, { 2, 2 } };
+    EXPECT_FALSE(setm::overlaps(circle, corner));
+    EXPECT_TRUE(setm::overlaps(circle, setm::Rectangle{ { 0.9, -3 }, { 2, 3 } }));
+    EXPECT_TRUE(setm::overlaps(setm::Rectangle{ { -5, -5 }, { 5, 5 } }, circle));  // Containment.
+
+    // Dispatch through the base class.
+    const setm::Shape& shape{ corner };
+    EXPECT_FALSE(setm::overlaps(shape, static_cast<const setm::Shape&>(circle)));
+    EXPECT_TRUE(setm::overlaps(shape, static_cast<const setm::Shape&>(rectangle)));
+
+    EXPECT_THROW(setm::CollisionGrid{ 0.0 }, std::invalid_argument);
+}
+
+TEST(CollisionTest, GridMatchesBruteForce) {
+    const std::vector<std::unique_ptr<setm::Shape>> owned{ makeShapes(3000, 5) };
+    setm::CollisionGrid grid{ 25.0 };
+    for(const std::unique_ptr<setm::Shape>& shape : owned) {
+        grid.insert(shape.get());
+    }
+    EXPECT_EQ(grid.size(), owned.size());
+    EXPECT_THROW(grid.insert(owned[0].get()), std::invalid_argument);
+
+    const auto bruteForce{ [&owned] {
+        std::vector<setm::CollisionGrid::Pair> pairs;
+        for(std::size_t i{}; i < owned.size(); ++i) {
+            for(std::size_t j{ i + 1 }; j < owned.size(); ++j) {
+                if(setm::overlaps(*owned[i], *owned[j])) {
+                    const setm::Shape* const first{ owned[i].get() };
+                    const setm::Shape* const second{ owned[j].get() };
+                    pairs.push_back(first < second ? setm::CollisionGrid::Pair{ first, second } : setm::CollisionGrid::Pair{ second, first });
+                }
+            }
+        }
+        std::ranges::sort(pairs);
+        return pairs;
+    } };
+
+    const std::vector<setm::CollisionGrid::Pair> expected{ bruteForce() };
+    EXPECT_FALSE(expected.empty());
+    EXPECT_EQ(grid.findPairs(1), expected);
+    EXPECT_EQ(grid.findPairs(4), expected);
+
+    // Next frame: grow some shapes and shrink others, then refresh only those.
+    for(std::size_t i{}; i < owned.size(); i += 7) {
+        owned[i]->scale(i % 2 == 0 ? 3.0 : 0.25);
+        grid.update(owned[i].get());
+    }
+    EXPECT_EQ(grid.findPairs(4), bruteForce());
+
+    // Next frame: everything grows and the whole grid is refreshed.
+    for(const std::unique_ptr<setm::Shape>& shape : owned) {
+        shape->scale(1.5);
+    }
+    grid.updateAll();
+    EXPECT_EQ(grid.findPairs(3), bruteForce());
+
+    // Removed shapes are no longer reported.
+    EXPECT_TRUE(grid.remove(owned[0].get()));
+    EXPECT_FALSE(grid.remove(owned[0].get()));
+    EXPECT_THROW(grid.update(owned[0].get()), std::invalid_argument);
+    for(const setm::CollisionGrid::Pair& pair : grid.findPairs()) {
+        EXPECT_NE(pair.first, owned[0].get());
+        EXPECT_NE(pair.second, owned[0].get());
+    }
+}
+
+TEST(CollisionTest, OversizedShapes) {
+    std::vector<std::unique_ptr<setm::Shape>> owned{ makeShapes(500, 8) };
+    owned.push_back(std::make_unique<setm::Rectangle>(setm::Point{ -5e4, -5e4 }, setm::Point{ 5e4, 5e4 }));
+    owned.push_back(std::make_unique<setm::Rectangle>(setm::Point{ 100, 100 }, setm::Point{ 300, 300 }));
+    owned.push_back(std::make_unique<setm::Circle>(setm::Point{ 2e4, 0 }, 10.0));  // Far away from the small shapes.
+
+    // With unit cells the large rectangles would cover billions of cells; they are kept aside instead.
+    setm::CollisionGrid grid{ 1.0 };
+    for(const std::unique_ptr<setm::Shape>& shape : owned) {
+        grid.insert(shape.get());
+    }
+
+    const auto bruteForce{ [&owned] {
+        std::vector<setm::CollisionGrid::Pair> pairs;
+        for(std::size_t i{}; i < owned.size(); ++i) {
+            for(std::size_t j{ i + 1 }; j < owned.size(); ++j) {
+                if(setm::overlaps(*owned[i], *owned[j])) {
+                    const setm::Shape* const first{ owned[i].get() };
+                    const setm::Shape* const second{ owned[j].get() };
+                    pairs.push_back(first < second ? setm::CollisionGrid::Pair{ first, second } : setm::CollisionGrid::Pair{ second, first });
+                }
+            }
+        }
+        std::ranges::sort(pairs);
+        return pairs;
+    } };
+    EXPECT_EQ(grid.findPairs(1), bruteForce());
+    EXPECT_EQ(grid.findPairs(4), bruteForce());
+
+    // Shapes move between the cells and the oversized list as they grow and shrink.
+    owned[0]->scale(40.0);
+    owned[500]->scale(1e-5);
+    grid.update(owned[0].get());
+    grid.update(owned[500].get());
+    EXPECT_EQ(grid.findPairs(3), bruteForce());
+
+    EXPECT_TRUE(grid.remove(owned[501].get()));
+    EXPECT_TRUE(grid.remove(owned[0].get()));
+    for(const setm::CollisionGrid::Pair& pair : grid.findPairs()) {
+        EXPECT_NE(pair.first, owned[501].get());
+        EXPECT_NE(pair.second, owned[0].get());
+        EXPECT_NE(pair.first, owned[0].get());
+        EXPECT_NE(pair.second, owned[501].get());
+    }
+}
+
+TEST(SortingTest, RadixOrderOfKeys) {
+    constexpr double infinity{ std::numeric_limits<double>::infinity() };
+    const std::vector<double> keys{ 3.5, -0.0, -infinity, 1e-300, -2.0, 0.0, infinity, -1e-300, 3.5, -2.5 };
+    const std::vector<std::size_t> expected{ 2, 9, 4, 7, 1, 5, 3, 0, 8, 6 };  // Stable: equal keys keep their order.
+    EXPECT_EQ(setm::sortedOrder(keys), expected);
+    EXPECT_TRUE(setm::sortedOrder({}).empty());
+
+    // Many keys on several threads match std::stable_sort.
+    std::mt19937 generator{ 6 };
+    std::uniform_real_distribution<double> distribution{ -1e6, 1e6 };
+    std::vector<double> many(200000);
+    for(double& key : many) {
+        key = std::round(distribution(generator) / 1000) * 1000;  // Plenty of duplicates.
+    }
+    std::vector<std::size_t> order(many.size());
+    for(std::size_t i{}; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::ranges::stable_sort(order, {}, [&many](std::size_t i) { return many[i]; });
+    EXPECT_EQ(setm::sortedOrder(many, 4), order);
+    EXPECT_EQ(setm::sortedOrder(many, 1), order);
+}
+
+TEST(SortingTest, SortByArea) {
+    const std::vector<std::unique_ptr<setm::Shape>> owned{ makeShapes(100000, 7) };
+    std::vector<setm::Shape*> shapes;
+    std::vector<setm::AnyShape> values;
+    for(const std::unique_ptr<setm::Shape>& shape : owned) {
+        shapes.push_back(shape.get());
+        if(const auto* const circle{ dynamic_cast<const setm::Circle*>(shape.get()) }) {
+            values.emplace_back(*circle);
+        } else {
+            values.emplace_back(dynamic_cast<const setm::Rectangle&>(*shape));
+        }
+    }
+
+    // Same result as comparing shapes with operator<.
+    std::vector<setm::Shape*> expected{ shapes };
+    std::ranges::stable_sort(expected, [](const setm::Shape* lhs, const setm::Shape* rhs) { return *lhs < *rhs; });
+    setm::sortByArea(shapes, 4);
+    EXPECT_EQ(shapes, expected);
+
+    setm::sortByArea(values, 2);
+    for(std::size_t i{}; i < values.size(); ++i) {
+        EXPECT_EQ(values[i].getArea(), expected[i]->getArea());
+    }
+
+    // Any key works, e.g. descending x coordinate of the center.
+    setm::sortBy(shapes, [](const setm::Shape* shape) { return -shape->getCenter().x; });
+    EXPECT_TRUE(std::ranges::is_sorted(shapes, std::greater{}, [](const setm::Shape* shape) { return shape->getCenter().x; }));
+}
+
+TEST(ShapeFactoryTest, ArenaHandles) {
+    setm::ShapeFactory factory;
+    setm::ShapeFactory::Handle<setm::Circle> first{ factory.makeCircle({ 0, 0 }, 1.0) };
+    setm::ShapeFactory::Handle<setm::Circle> second{ factory.makeCircle({ 1, 1 }, 2.0) };
+    const setm::ShapeFactory::Handle<setm::Rectangle> rectangle{ factory.makeRectangle({ 0, 0 }, { 2, 3 }) };
+    EXPECT_DOUBLE_EQ(second->getArea(), std::numbers::pi_v<double> * 4.0);
+    EXPECT_DOUBLE_EQ(rectangle->getArea(), 6.0);
+    EXPECT_EQ(second.get() - first.get(), 1);  // Same-type shapes are contiguous.
+    EXPECT_EQ(factory.liveCount(), 3U);
+
+    // Invalid shapes throw and are not counted.
+    EXPECT_THROW(factory.makeCircle({ 0, 0 }, 0.0), std::invalid_argument);
+    EXPECT_EQ(factory.liveCount(), 3U);
+
+    // Handles convert to handles of the base class.
+    std::vector<setm::ShapeFactory::Handle<setm::Shape>> shapes;
+    shapes.push_back(std::move(first));
+    shapes.push_back(std::move(second));
+    EXPECT_EQ(shapes[1]->getName(), "CIRCLE");
+
+    // Memory is only released when no shape is alive.
+    EXPECT_THROW(factory.reset(), std::logic_error);
+    shapes.clear();
+    EXPECT_EQ(factory.liveCount(), 1U);
+    EXPECT_THROW(factory.reset(), std::logic_error);
+}
+
+TEST(ShapeFactoryTest, PerThreadArenasAndReset) {
+    setm::ShapeFactory factory;
+    for(int frame{}; frame < 3; ++frame) {
+        // Several threads fill the scene at once.
+        std::vector<std::vector<setm::ShapeFactory::Handle<setm::Shape>>> scene(4);
+        std::vector<std::thread> threads;
+        for(std::size_t part{}; part < scene.size(); ++part) {
+            threads.emplace_back([&factory, &shapes = scene[part], part] {
+                for(int i{ 1 }; i <= 10000; ++i) {
+                    if(i % 2 == 0) {
+                        shapes.push_back(factory.makeCircle({ static_cast<double>(part), 0 }, i));
+                    } else {
+                        shapes.push_back(factory.makeRectangle({ 0, 0 }, { static_cast<double>(part + 1), static_cast<double>(i) }));
+                    }
+                }
+            });
+        }
+        for(std::thread& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(factory.liveCount(), 40000U);
+
+        // Every shape kept its own values.
+        for(std::size_t part{}; part < scene.size(); ++part) {
+            EXPECT_DOUBLE_EQ(scene[part][9998]->getArea(), static_cast<double>(part + 1) * 9999.0);
+            EXPECT_DOUBLE_EQ(scene[part][9999]->getArea(), std::numbers::pi_v<double> * 10000.0 * 10000.0);
+        }
+
+        // End of frame: drop the shapes and release all the memory at once.
+        scene.clear();
+        EXPECT_EQ(factory.liveCount(), 0U);
+        EXPECT_NO_THROW(factory.reset());
+    }
+}